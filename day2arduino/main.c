@@ -97,40 +97,78 @@ void init_hardware(void)
   buzzer_init();
 }
 
-// ============================================================================
-// [MODE 0] Text Scrolling
-// ============================================================================
-#define TEXT_BAM_LOOP 20
-#define TEXT_SCROLL_SPEED 1
-#define TEXT_COLOR_SPEED 3
-
-static int16_t txt_s1 = 64, txt_s2 = 64, txt_s3 = 64, txt_s4 = 64;
-static uint16_t txt_color_tick = 0;
-static uint16_t txt_scroll_timer = 0;
+// 한 row 의 BAM 3 plane 출력 (파이프라인)
+// plane k 를 래치해서 켜 둔 채로 plane k+1 을 밀어넣고, 표시 시간(base_cols << k 컬럼)이
+// 지나면 시프트 도중에 OE 를 끈다. 밝기 비율은 그대로, plane 시간은 시프트 + 표시 → max(시프트, 표시)
+// row 사이에는 logic_mode_*() 가 frame_buffer 를 다시 채우므로 겹치기는 row 안에서만
+#define SCAN_COL_CYCLES 13 // 컬럼 하나: ld + PORTD 쓰기 + CLK 상승/하강 + 루프
+
+#define SHIFT_COL(p)                   \
+  do                                   \
+  {                                    \
+    PORTD = (PORTD & 0x03) | *(p)++;   \
+    PORTB |= (1 << PIN_CLK);           \
+    PORTB &= ~(1 << PIN_CLK);          \
+  } while (0)
+
+// 시프트 없이 cols 컬럼 시간만큼 대기 (_delay_loop_2 1회 = 4 사이클)
+static void hold_cols(uint16_t cols)
+{
+  uint16_t n = (uint16_t)(((uint32_t)cols * SCAN_COL_CYCLES) >> 2);
+  if (n)
+  {
+    _delay_loop_2(n);
+  }
+}
 
-void render_mode_text(uint8_t row)
+void render_row_bam(uint8_t row, uint8_t base_cols)
 {
+  const uint8_t *ptr = frame_buffer;
+  uint16_t on = 0; // 지금 켜져 있는 plane 의 표시 시간 (컬럼 단위)
+
   PORTB |= (1 << PIN_OE);
   PORTC = (PORTC & 0xF0) | (row & 0x0F);
   for (uint8_t plane = 0; plane < 3; plane++)
   {
-    uint8_t *ptr = &frame_buffer[plane * 128];
-    for (uint8_t i = 0; i < 128; i++)
+    uint8_t split = (on < 128) ? (uint8_t)on : 128;
+    uint8_t i = 0;
+    for (; i < split; i++)
+    {
+      SHIFT_COL(ptr);
+    }
+    if (on > 128)
     {
-      PORTB &= ~(1 << PIN_CLK);
-      PORTD = (PORTD & 0x03) | *ptr++;
-      PORTB |= (1 << PIN_CLK);
+      hold_cols(on - 128); // 시프트보다 표시가 길면 나머지만큼 더 켜 둠
     }
+    PORTB |= (1 << PIN_OE); // 앞 plane 표시 끝
+    for (; i < 128; i++)
+    {
+      SHIFT_COL(ptr);
+    }
+
     PORTB |= (1 << PIN_LAT);
     PORTB &= ~(1 << PIN_LAT);
     PORTB &= ~(1 << PIN_OE);
-    uint16_t loops = TEXT_BAM_LOOP * (1 << plane);
-    while (loops--)
-    {
-      __asm__ __volatile__("nop");
-    }
-    PORTB |= (1 << PIN_OE);
+    on = (uint16_t)base_cols << plane;
   }
+  hold_cols(on);
+  PORTB |= (1 << PIN_OE);
+}
+
+// ============================================================================
+// [MODE 0] Text Scrolling
+// ============================================================================
+#define TEXT_BAM_COLS 9 // plane 0 표시 시간 (컬럼 단위, 이전 nop 루프 20회 ≈ 120 사이클)
+#define TEXT_SCROLL_SPEED 1
+#define TEXT_COLOR_SPEED 3
+
+static int16_t txt_s1 = 64, txt_s2 = 64, txt_s3 = 64, txt_s4 = 64;
+static uint16_t txt_color_tick = 0;
+static uint16_t txt_scroll_timer = 0;
+
+void render_mode_text(uint8_t row)
+{
+  render_row_bam(row, TEXT_BAM_COLS);
 }
 
 void logic_mode_text(uint8_t row)
@@ -348,34 +386,14 @@ void update_mode_text(void)
 // ============================================================================
 // [MODE 1] Diamond Ripple
 // ============================================================================
-#define SPEC_BAM_LOOP 40
+#define SPEC_BAM_COLS 18 // 이전 nop 루프 40회 ≈ 240 사이클
 #define SPEC_SPEED_STEP 3
 
 static uint16_t spec_t_val = 0;
 
 void render_mode_spectrum(uint8_t row)
 {
-  PORTB |= (1 << PIN_OE);
-  PORTC = (PORTC & 0xF0) | (row & 0x0F);
-  for (uint8_t plane = 0; plane < 3; plane++)
-  {
-    uint8_t *ptr = &frame_buffer[plane * 128];
-    for (uint8_t i = 0; i < 128; i++)
-    {
-      PORTB &= ~(1 << PIN_CLK);
-      PORTD = (PORTD & 0x03) | *ptr++;
-      PORTB |= (1 << PIN_CLK);
-    }
-    PORTB |= (1 << PIN_LAT);
-    PORTB &= ~(1 << PIN_LAT);
-    PORTB &= ~(1 << PIN_OE);
-    uint16_t loops = SPEC_BAM_LOOP * (1 << plane);
-    while (loops--)
-    {
-      __asm__ __volatile__("nop");
-    }
-    PORTB |= (1 << PIN_OE);
-  }
+  render_row_bam(row, SPEC_BAM_COLS);
 }
 
 void logic_mode_spectrum(uint8_t row)
@@ -451,7 +469,7 @@ void update_mode_spectrum(void)
 // ============================================================================
 // [MODE 2] Mario (Black BG, Blocks, Coins)
 // ============================================================================
-#define MARIO_BASE_TIME 4
+#define MARIO_BAM_COLS 5 // 이전 4us = 64 사이클
 
 static uint16_t mar_scroll_x = 0;
 static uint8_t mar_frame_tick = 0;
@@ -469,34 +487,7 @@ static uint8_t mar_coin_y = 0;
 
 void render_mode_mario(uint8_t row)
 {
-  for (uint8_t plane = 0; plane < 3; plane++)
-  {
-    PORTB |= (1 << PIN_OE);
-    PORTC = (PORTC & 0xF0) | (row & 0x0F);
-    uint8_t *ptr = &frame_buffer[plane * 128];
-    for (uint8_t col = 0; col < 128; col++)
-    {
-      PORTD = (PORTD & 0x03) | *ptr++;
-      PORTB |= (1 << PIN_CLK);
-      PORTB &= ~(1 << PIN_CLK);
-    }
-    PORTB |= (1 << PIN_LAT);
-    PORTB &= ~(1 << PIN_LAT);
-    PORTB &= ~(1 << PIN_OE);
-    if (plane == 0)
-    {
-      _delay_us(MARIO_BASE_TIME);
-    }
-    else if (plane == 1)
-    {
-      _delay_us(MARIO_BASE_TIME * 2);
-    }
-    else
-    {
-      _delay_us(MARIO_BASE_TIME * 4);
-    }
-  }
-  PORTB |= (1 << PIN_OE);
+  render_row_bam(row, MARIO_BAM_COLS);
 }
 
 // Helper macro for drawing colored pixels
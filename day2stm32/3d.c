@@ -1,7 +1,56 @@
 #include "3d.h"
+#include "xform.h"
 #include <math.h>
-
-row_t fb[SCREEN_H]; // frame buffer
+#include <string.h>
+#if RENDER_DMA_CLEAR
+#include "blit.h"
+#endif
+#if RENDER_FBPAL
+#include "fbpal.h"
+#endif
+#if RENDER_BITFB
+#include "bitfb.h"
+#endif
+
+#if RENDER_BANDS && !CUBE_FIXED
+#error "RENDER_BANDS 는 Q16 메시 경로 전용 (CUBE_FIXED=1)"
+#endif
+
+// 밴드 모드 벤치마크는 비교용 fb 경로도 같이 빌드
+#if !RENDER_BANDS || defined(CUBE_BENCH)
+#define RENDER_FB 1
+#else
+#define RENDER_FB 0
+#endif
+
+#if RENDER_FB
+row_t fb[SCREEN_H] __attribute__((aligned(16))); // frame buffer (16바이트 정렬: DMA 버스트)
+#endif
+
+#if RENDER_ZBUF
+// 1/z (Q16) → 깊이 (Q12): (1/NEAR - 1/z) × ZBUF_K >> 8, 1/FAR 에서 255 × 4096
+#define ZBUF_INV_NEAR ((int32_t)(65536.0f / ZBUF_NEAR))
+#define ZBUF_INV_FAR ((int32_t)(65536.0f / ZBUF_FAR))
+#define ZBUF_K ((int32_t)(255.0f * 4096 * 256 / (ZBUF_INV_NEAR - ZBUF_INV_FAR)))
+#define ZBUF_D_MAX (255 << 12)
+
+// 깊이 버퍼: 0 = ZBUF_NEAR, 255 = ZBUF_FAR (1/z 기준이라 화면에서 선형 보간 가능)
+#if RENDER_FB
+static uint8_t zbuf[SCREEN_H][SCREEN_W] __attribute__((aligned(16)));
+#endif
+static uint8_t zbuf_on;
+
+// 꺼져 있는 동안은 지우지 않았으므로 켤 때 한 번 전체를 (이후로는 그린 영역만 지워도 됨)
+void render_set_zbuf(uint8_t on)
+{
+#if RENDER_FB
+  if (on && !zbuf_on) memset(zbuf, 0xFF, sizeof(zbuf));
+#endif
+  zbuf_on = on;
+}
+#else
+void render_set_zbuf(uint8_t on) { (void)on; }
+#endif
 
 //==================== 3D/2D 벡터 정의 ====================//
 
@@ -18,6 +67,7 @@ typedef struct
 
 //==================== 큐브 정점/면 정의 ====================//
 
+#if !CUBE_FIXED || defined(CUBE_BENCH)
 // -1 ~ 1 범위의 정규화된 큐브
 static const vec3f_t cube_vertices[8] = {
     {-1.0f, -1.0f, -1.0f},
@@ -29,6 +79,7 @@ static const vec3f_t cube_vertices[8] = {
     {1.0f, -1.0f, 1.0f},
     {1.0f, 1.0f, 1.0f},
     {-1.0f, 1.0f, 1.0f}};
+#endif
 
 typedef struct
 {
@@ -36,6 +87,7 @@ typedef struct
   uint8_t r, g, b; // 면 색상
 } face_t;
 
+#if !CUBE_FIXED || defined(CUBE_BENCH)
 // 앞/뒤/좌/우/위/아래 6면
 static const face_t cube_faces[6] = {
     {{0, 1, 2, 3}, 255, 0, 0},   // 앞   - 빨강
@@ -51,7 +103,9 @@ static const face_t cube_faces[6] = {
                                  // {{3, 2, 6, 7}, 180, 220, 250}, // 위 - 스카이 블루
                                  // {{0, 1, 5, 4}, 210, 150, 230}  // 아래 - 퍼플
 };
+#endif
 
+#if !CUBE_FIXED || defined(CUBE_BENCH)
 // 큐브 각 면의 노멀(모델 공간)
 static const vec3f_t face_normals_model[6] = {
     {0.0f, 0.0f, -1.0f}, // 앞
@@ -61,30 +115,179 @@ static const vec3f_t face_normals_model[6] = {
     {0.0f, 1.0f, 0.0f},  // 위
     {0.0f, -1.0f, 0.0f}, // 아래
 };
+#endif
 
 //==================== 픽셀/프레임 버퍼 유틸 ====================//
 
+#if RENDER_BANDS
+// 밴드 렌더 중인 row 들 (band_n == 0 이면 fb 에 그림)
+// 한 밴드 = 스캔 주소 하나가 쓰는 row 들 = 768바이트 (+ 깊이 256바이트), fb 12KB 대신
+static row_t band_buf[RENDER_BAND_ROWS];
+#if RENDER_ZBUF
+static uint8_t band_z[RENDER_BAND_ROWS][SCREEN_W];
+#endif
+static const uint8_t *band_y;
+static uint8_t band_n;
+#endif
+
+#if RENDER_FB
+// fb 에서 0 이 아닐 수 있는 영역: 지난 지우기 이후 그린 것 (fb_drawn), 그 전 프레임 것 (fb_prev)
+static fb_rect_t fb_drawn = {0, 0, -1, -1};
+static fb_rect_t fb_prev = {0, 0, -1, -1};
+
+static inline void fb_touch(int x0, int y0, int x1, int y1)
+{
+  if (fb_drawn.x0 > fb_drawn.x1)
+  {
+    fb_drawn = (fb_rect_t){(int16_t)x0, (int16_t)y0, (int16_t)x1, (int16_t)y1};
+    return;
+  }
+  if (x0 < fb_drawn.x0) fb_drawn.x0 = (int16_t)x0;
+  if (x1 > fb_drawn.x1) fb_drawn.x1 = (int16_t)x1;
+  if (y0 < fb_drawn.y0) fb_drawn.y0 = (int16_t)y0;
+  if (y1 > fb_drawn.y1) fb_drawn.y1 = (int16_t)y1;
+}
+
+#if RENDER_DMA_CLEAR
+void render_clear_wait(void) { blit_wait(); }
+#else
+void render_clear_wait(void) {}
+#endif
+
+// z-buffer 를 쓰는 중이면 같은 row 루프에서 깊이도 가장 먼 값으로
+// 전에 뭐가 있었는지 모르므로 다음 render_dirty_rect() 는 화면 전체
 void clear_framebuffer(void)
 {
+#if RENDER_DMA_CLEAR
+  blit_fill(fb, 0, sizeof(fb), NULL, NULL);
+#if RENDER_ZBUF
+  if (zbuf_on) blit_fill(zbuf, 0xFF, sizeof(zbuf), NULL, NULL);
+#endif
+#else
   for (int y = 0; y < SCREEN_H; y++)
   {
-    for (int x = 0; x < SCREEN_W; x++)
-    {
-      fb[y].r[x] = 0;
-      fb[y].g[x] = 0;
-      fb[y].b[x] = 0;
-    }
+    memset(&fb[y], 0, sizeof(row_t));
+#if RENDER_ZBUF
+    if (zbuf_on) memset(zbuf[y], 0xFF, SCREEN_W);
+#endif
   }
+#endif
+  fb_prev = (fb_rect_t){0, 0, SCREEN_W - 1, SCREEN_H - 1};
+  fb_drawn = (fb_rect_t){0, 0, -1, -1};
 }
 
-static inline void put_pixel(int x, int y,
-                             uint8_t r, uint8_t g, uint8_t b)
+// 지난번에 그린 사각형만 지움 (깊이는 그린 픽셀에만 쓰므로 같은 사각형)
+void clear_framebuffer_dirty(void)
+{
+  const fb_rect_t r = fb_drawn;
+  int n = r.x1 - r.x0 + 1;
+
+#if RENDER_DMA_CLEAR
+  // DMA 는 CPU 를 쓰지 않으니 줄마다 인터럽트로 다시 거는 사각형 대신 그 row 들 전체를 한 번에
+  // (사각형 밖은 이미 0 / 0xFF 라서 더 지워도 같음)
+  if (n > 0 && r.y0 <= r.y1)
+  {
+    blit_fill(&fb[r.y0], 0, (r.y1 - r.y0 + 1) * sizeof(row_t), NULL, NULL);
+#if RENDER_ZBUF
+    if (zbuf_on) blit_fill(zbuf[r.y0], 0xFF, (r.y1 - r.y0 + 1) * SCREEN_W, NULL, NULL);
+#endif
+  }
+#else
+  for (int y = r.y0; y <= r.y1 && n > 0; y++)
+  {
+    memset(&fb[y].r[r.x0], 0, n);
+    memset(&fb[y].g[r.x0], 0, n);
+    memset(&fb[y].b[r.x0], 0, n);
+#if RENDER_ZBUF
+    if (zbuf_on) memset(&zbuf[y][r.x0], 0xFF, n);
+#endif
+  }
+#endif
+  fb_prev = r;
+  fb_drawn = (fb_rect_t){0, 0, -1, -1};
+}
+
+fb_rect_t render_dirty_rect(void) { return fb_rect_union(fb_prev, fb_drawn); }
+
+static inline void put_pixel_rgb(int x, int y,
+                                 uint8_t r, uint8_t g, uint8_t b)
 {
   if (x < 0 || x >= SCREEN_W || y < 0 || y >= SCREEN_H) return;
+  fb_touch(x, y, x, y);
   fb[y].r[x] = r;
   fb[y].g[x] = g;
   fb[y].b[x] = b;
 }
+#endif
+
+static fb_format_t draw_format = FB_RGB;
+
+void render_set_format(fb_format_t f)
+{
+#if !RENDER_FBPAL
+  if (f == FB_INDEXED) return;
+#endif
+#if !RENDER_BITFB
+  if (f == FB_BITPLANE) return;
+#endif
+  draw_format = f;
+}
+
+fb_format_t render_get_format(void) { return draw_format; }
+
+void put_pixel(int x, int y, uint32_t color)
+{
+#if RENDER_FBPAL
+  if (draw_format == FB_INDEXED)
+  {
+    fbpal_put_pixel(x, y, (uint8_t)color);
+    return;
+  }
+#endif
+#if RENDER_BITFB
+  if (draw_format == FB_BITPLANE)
+  {
+    bitfb_put_pixel(x, y, bitfb_rgb(color));
+    return;
+  }
+#endif
+#if RENDER_FB
+  put_pixel_rgb(x, y, (uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color);
+#else
+  (void)x, (void)y, (void)color;
+#endif
+}
+
+void fb_hline(int x0, int x1, int y, uint32_t color)
+{
+  if (y < 0 || y >= SCREEN_H) return;
+  if (x0 < 0) x0 = 0;
+  if (x1 >= SCREEN_W) x1 = SCREEN_W - 1;
+  if (x0 > x1) return;
+
+#if RENDER_FBPAL
+  if (draw_format == FB_INDEXED)
+  {
+    fbpal_hline(x0, x1, y, (uint8_t)color);
+    return;
+  }
+#endif
+#if RENDER_BITFB
+  if (draw_format == FB_BITPLANE)
+  {
+    bitfb_hline(x0, x1, y, bitfb_rgb(color));
+    return;
+  }
+#endif
+#if RENDER_FB
+  fb_touch(x0, y, x1, y);
+  memset(&fb[y].r[x0], (uint8_t)(color >> 16), x1 - x0 + 1);
+  memset(&fb[y].g[x0], (uint8_t)(color >> 8), x1 - x0 + 1);
+  memset(&fb[y].b[x0], (uint8_t)color, x1 - x0 + 1);
+#else
+  (void)color;
+#endif
+}
 
 //==================== 삼각형 채우기 ====================//
 
@@ -111,8 +314,10 @@ static inline int max3(int a, int b, int c)
   return (m > c) ? m : c;
 }
 
-static void fill_triangle(vec2i_t v0, vec2i_t v1, vec2i_t v2,
-                          uint8_t r, uint8_t g, uint8_t b)
+#ifdef CUBE_BENCH
+// 기존 방식: 바운딩 박스의 모든 픽셀에서 edge_function 3번 (벤치마크 비교용으로 남겨 둠)
+static void fill_triangle_ref(vec2i_t v0, vec2i_t v1, vec2i_t v2,
+                              uint8_t r, uint8_t g, uint8_t b)
 {
   int minX = min3(v0.x, v1.x, v2.x);
   int maxX = max3(v0.x, v1.x, v2.x);
@@ -141,76 +346,465 @@ static void fill_triangle(vec2i_t v0, vec2i_t v1, vec2i_t v2,
       if ((w0 >= 0 && w1 >= 0 && w2 >= 0) ||
           (w0 <= 0 && w1 <= 0 && w2 <= 0))
       {
-        put_pixel(x, y, r, g, b);
+        put_pixel_rgb(x, y, r, g, b);
       }
     }
   }
 }
+#endif
+
+//==================== 볼록 다각형 스팬 채우기 ====================//
+// row y 에서 닫힌 볼록 다각형의 단면은 [모서리 교점 x 의 최소, 최대] 이므로
+// 모서리마다 지나는 row 의 교점을 구해 ceil 은 span_lo 에, floor 는 span_hi 에 모으고
+// row 마다 span_lo ~ span_hi 를 한 번에 채운다. 경계 포함 규칙이 edge_function 채우기와 같아서 결과 픽셀도 같음
+
+static int16_t span_lo[SCREEN_H], span_hi[SCREEN_H];
+
+// b > 0 일 때 floor(a / b) (C 나눗셈은 0 쪽으로 버림)
+static inline int floor_div(int a, int b)
+{
+  int q = a / b;
+  if (a % b < 0) q--;
+  return q;
+}
+
+// 모서리 a-b 가 row y_lo ~ y_hi 에서 만나는 x 를 span_lo/hi 에 반영
+// x = a.x + (y - a.y) * dx / dy 를 정수부 x + 나머지 r/dy 고정소수점으로 한 row 씩 누적
+// (나눗셈은 시작할 때만, 나머지를 분수 그대로 들고 가서 누적 오차 없음)
+static void span_edge(vec2i_t a, vec2i_t b, int y_lo, int y_hi)
+{
+  if (a.y > b.y)
+  {
+    vec2i_t t = a;
+    a = b;
+    b = t;
+  }
+
+  int y0 = (a.y > y_lo) ? a.y : y_lo;
+  int y1 = (b.y < y_hi) ? b.y : y_hi;
+  if (y0 > y1) return;
+
+  if (a.y == b.y) // 수평 모서리: 양 끝점이 그대로 단면
+  {
+    int lo = (a.x < b.x) ? a.x : b.x;
+    int hi = (a.x < b.x) ? b.x : a.x;
+    if (lo < span_lo[y0]) span_lo[y0] = lo;
+    if (hi > span_hi[y0]) span_hi[y0] = hi;
+    return;
+  }
+
+  int dx = b.x - a.x, dy = b.y - a.y;
+  int step = floor_div(dx, dy), rstep = dx - step * dy; // 0 <= rstep < dy
+  int num = (y0 - a.y) * dx;
+  int q = floor_div(num, dy);
+  int x = a.x + q, r = num - q * dy;
+
+  for (int y = y0; y <= y1; y++)
+  {
+    int xc = x + (r != 0); // ceil
+    if (xc < span_lo[y]) span_lo[y] = xc;
+    if (x > span_hi[y]) span_hi[y] = x;
+
+    x += step;
+    r += rstep;
+    if (r >= dy)
+    {
+      r -= dy;
+      x++;
+    }
+  }
+}
 
-// quad(4점 면)을 삼각형 2개로 나눠서 채우기
+// 화면 공간 선형 보간 값 v(x, y) = d0 + dx × (x - x0) + dy × (y - y0), Q12
+// (깊이 0 ~ 255, 색 0 ~ 255 모두 × 4096)
+typedef struct
+{
+  int32_t d0, dx, dy;
+  int32_t lo, hi; // 꼭짓점 값 범위
+} plane_t;
+
+// 스팬 채우기에서 보간할 값들 (기준점은 같이 씀)
+typedef struct
+{
+  int16_t x0, y0;
+  uint8_t use_z; // 1: 깊이 비교 (RENDER_ZBUF)
+  plane_t z;
+  plane_t c[3]; // r, g, b (flat 이면 기울기 0)
+} span_attr_t;
+
+// 꼭짓점 세 개의 값으로 평면 기울기, area = (b - a) x (c - a)
+// 화면 좌표 ±256, 값 차 2^20 이하라서 분자는 int32 에 들어감
+static void plane_init(plane_t *pl, vec2i_t a, vec2i_t b, vec2i_t c, int32_t va, int32_t vb, int32_t vc, int area)
+{
+  pl->dx = ((vb - va) * (c.y - a.y) - (vc - va) * (b.y - a.y)) / area;
+  pl->dy = ((vc - va) * (b.x - a.x) - (vb - va) * (c.x - a.x)) / area;
+  pl->d0 = va;
+  pl->lo = (va < vb) ? va : vb;
+  pl->hi = (va < vb) ? vb : va;
+  if (vc < pl->lo) pl->lo = vc;
+  if (vc > pl->hi) pl->hi = vc;
+}
+
+static inline int32_t plane_at(const plane_t *pl, int ox, int oy)
+{
+  return (int32_t)(pl->d0 + (int64_t)pl->dx * ox + (int64_t)pl->dy * oy);
+}
+
+// 스팬 시작값과 픽셀당 증가량
+// 반올림된 모서리가 면 밖 픽셀을 조금 덮으면 가는 면에서는 외삽값이 크게 튀므로 (uint8 넘침)
+// 양 끝을 꼭짓점 범위로 자르고, 잘렸을 때만 증가량을 다시 구함 (나눗셈은 그 줄에서만)
+static inline int32_t span_start(const plane_t *pl, int ox, int oy, int len, int32_t *step)
+{
+  int32_t s = plane_at(pl, ox, oy), e = s + pl->dx * len;
+  *step = pl->dx;
+  if (s < pl->lo || s > pl->hi || e < pl->lo || e > pl->hi)
+  {
+    s = (s < pl->lo) ? pl->lo : (s > pl->hi) ? pl->hi : s;
+    e = (e < pl->lo) ? pl->lo : (e > pl->hi) ? pl->hi : e;
+    *step = len ? (e - s) / len : 0;
+  }
+  return s;
+}
+
+// 꼭짓점 i0, i1, i2 로 보간 준비 (화면에서 면적 0 이면 0 반환)
+// z: 꼭짓점 깊이 (Q12) 또는 NULL, c: 꼭짓점 색 (Q12, 반올림 0.5 포함) 또는 NULL 이면 r, g, b 한 색
+static int span_attr_init(span_attr_t *sa, const vec2i_t *p, int i0, int i1, int i2,
+                          const int32_t *z, const int32_t (*c)[3], uint8_t r, uint8_t g, uint8_t b)
+{
+  int area = edge_function(p[i0], p[i2], p[i1]);
+  if (area == 0) return 0;
+
+  sa->x0 = p[i0].x;
+  sa->y0 = p[i0].y;
+  sa->use_z = z != NULL;
+  if (z) plane_init(&sa->z, p[i0], p[i1], p[i2], z[i0], z[i1], z[i2], area);
+
+  const uint8_t flat[3] = {r, g, b};
+  for (uint8_t ch = 0; ch < 3; ch++)
+  {
+    if (c)
+    {
+      plane_init(&sa->c[ch], p[i0], p[i1], p[i2], c[i0][ch], c[i1][ch], c[i2][ch], area);
+    }
+    else
+    {
+      sa->c[ch].d0 = (flat[ch] << 12) + 2048;
+      sa->c[ch].dx = 0;
+      sa->c[ch].dy = 0;
+      sa->c[ch].lo = sa->c[ch].d0;
+      sa->c[ch].hi = sa->c[ch].d0;
+    }
+  }
+  return 1;
+}
+
+// 스팬 한 줄을 보간하며 채우기: 픽셀마다 색 덧셈 세 번 (+ 깊이 덧셈/비교 한 번)
+// 깊이가 같으면 나중 면이 덮음 (painter 와 같게)
+// row / zrow: 그릴 row (fb 또는 밴드) 와 그 깊이 row, y 는 보간 위치
+static void span_fill_attr(row_t *row, uint8_t *zrow, int y, int x0, int x1, const span_attr_t *sa)
+{
+  int ox = x0 - sa->x0, oy = y - sa->y0, len = x1 - x0;
+  int32_t dr, dg, db;
+  int32_t cr = span_start(&sa->c[0], ox, oy, len, &dr);
+  int32_t cg = span_start(&sa->c[1], ox, oy, len, &dg);
+  int32_t cb = span_start(&sa->c[2], ox, oy, len, &db);
+  uint8_t *pr = row->r, *pg = row->g, *pb = row->b;
+
+#if RENDER_ZBUF
+  if (sa->use_z)
+  {
+    int32_t d = plane_at(&sa->z, ox, oy), dz = sa->z.dx;
+
+    for (int x = x0; x <= x1; x++, d += dz, cr += dr, cg += dg, cb += db)
+    {
+      int32_t zv = d >> 12;
+      if (zv > zrow[x]) continue;
+      zrow[x] = (uint8_t)((zv < 0) ? 0 : zv);
+      pr[x] = (uint8_t)(cr >> 12);
+      pg[x] = (uint8_t)(cg >> 12);
+      pb[x] = (uint8_t)(cb >> 12);
+    }
+    return;
+  }
+#else
+  (void)zrow;
+#endif
+  for (int x = x0; x <= x1; x++, cr += dr, cg += dg, cb += db)
+  {
+    pr[x] = (uint8_t)(cr >> 12);
+    pg[x] = (uint8_t)(cg >> 12);
+    pb[x] = (uint8_t)(cb >> 12);
+  }
+}
+
+// span_lo/hi[y] 로 row 하나 채우기 (화면 밖은 자름)
+static inline void fill_row(row_t *row, uint8_t *zrow, int y, uint8_t r, uint8_t g, uint8_t b, const span_attr_t *sa)
+{
+  int x0 = (span_lo[y] < 0) ? 0 : span_lo[y];
+  int x1 = (span_hi[y] >= SCREEN_W) ? SCREEN_W - 1 : span_hi[y];
+  if (x0 > x1) return;
+
+  if (sa)
+  {
+    span_fill_attr(row, zrow, y, x0, x1, sa);
+    return;
+  }
+  memset(&row->r[x0], r, x1 - x0 + 1);
+  memset(&row->g[x0], g, x1 - x0 + 1);
+  memset(&row->b[x0], b, x1 - x0 + 1);
+}
+
+// 볼록 다각형 v[0..n-1] (감김 방향 무관) 채우기
+// sa 가 없으면 한 색 memset, 있으면 깊이/색 보간
+// 밴드 렌더 중이면 밴드 row 만 (모서리 교점은 row 하나씩 새로 구함, 누적하던 것과 같은 값)
+static void fill_convex(const vec2i_t *v, int n, uint8_t r, uint8_t g, uint8_t b, const span_attr_t *sa)
+{
+  int y_lo = v[0].y, y_hi = v[0].y, x_lo = v[0].x, x_hi = v[0].x;
+  for (int i = 1; i < n; i++)
+  {
+    if (v[i].y < y_lo) y_lo = v[i].y;
+    if (v[i].y > y_hi) y_hi = v[i].y;
+    if (v[i].x < x_lo) x_lo = v[i].x;
+    if (v[i].x > x_hi) x_hi = v[i].x;
+  }
+  if (y_lo < 0) y_lo = 0;
+  if (y_hi >= SCREEN_H) y_hi = SCREEN_H - 1;
+  if (y_lo > y_hi) return;
+
+#if RENDER_BANDS
+  if (band_n)
+  {
+    for (uint8_t j = 0; j < band_n; j++)
+    {
+      int y = band_y[j];
+      if (y < y_lo || y > y_hi) continue;
+      span_lo[y] = INT16_MAX;
+      span_hi[y] = INT16_MIN;
+      for (int i = 0; i < n; i++)
+      {
+        span_edge(v[i], v[(i + 1) % n], y, y);
+      }
+#if RENDER_ZBUF
+      fill_row(&band_buf[j], band_z[j], y, r, g, b, sa);
+#else
+      fill_row(&band_buf[j], NULL, y, r, g, b, sa);
+#endif
+    }
+    return;
+  }
+#endif
+
+#if RENDER_FB
+  // 스팬은 꼭짓점 x 범위 안 (ceil/floor) 이므로 바운딩 박스로 그린 영역을 넓힘
+  if (x_lo < 0) x_lo = 0;
+  if (x_hi >= SCREEN_W) x_hi = SCREEN_W - 1;
+  if (x_lo <= x_hi) fb_touch(x_lo, y_lo, x_hi, y_hi);
+
+  for (int y = y_lo; y <= y_hi; y++)
+  {
+    span_lo[y] = INT16_MAX;
+    span_hi[y] = INT16_MIN;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    span_edge(v[i], v[(i + 1) % n], y_lo, y_hi);
+  }
+
+  for (int y = y_lo; y <= y_hi; y++)
+  {
+#if RENDER_ZBUF
+    fill_row(&fb[y], zbuf[y], y, r, g, b, sa);
+#else
+    fill_row(&fb[y], NULL, y, r, g, b, sa);
+#endif
+  }
+#endif
+}
+
+// 네 꼭짓점에서 도는 방향이 모두 같으면 (0 은 허용, 전부 0 인 일직선은 제외) 볼록
+static int quad_is_convex(const vec2i_t *v)
+{
+  uint8_t pos = 0, neg = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    int turn = edge_function(v[i], v[(i + 1) & 3], v[(i + 2) & 3]);
+    pos |= turn > 0;
+    neg |= turn < 0;
+  }
+  return pos != neg;
+}
+
+#ifdef CUBE_BENCH
+static uint8_t fill_ref; // 1: 기존 삼각형 두 개 edge_function 채우기
+#endif
+
+// 면 채우기: 삼각형은 그대로, quad 는 볼록이면 스팬 한 번,
+// 정수로 반올림된 꼭짓점 때문에 오목/꼬인 경우만 기존처럼 삼각형 두 개 (면적 0 인 삼각형은 건너뜀)
+// z: 꼭짓점 깊이 (Q12) 가 있으면 깊이 비교 (평면인 면이라 quad 도 평면 하나)
+// c: 꼭짓점 색 (Q12) 이 있으면 Gouraud, 네 꼭짓점 색은 한 평면에 안 들어가므로 quad 는 삼각형 두 개
+static void fill_poly(const vec2i_t *p, int n, uint8_t r, uint8_t g, uint8_t b,
+                      const int32_t *z, const int32_t (*c)[3])
+{
+  span_attr_t sa;
+
+#ifdef CUBE_BENCH
+  if (fill_ref)
+  {
+    fill_triangle_ref(p[0], p[1], p[2], r, g, b);
+    if (n == 4) fill_triangle_ref(p[0], p[2], p[3], r, g, b);
+    return;
+  }
+#endif
+
+  if (c)
+  {
+    if (span_attr_init(&sa, p, 0, 1, 2, z, c, r, g, b)) fill_convex(p, 3, r, g, b, &sa);
+    if (n == 4)
+    {
+      vec2i_t t1[3] = {p[0], p[2], p[3]};
+      if (span_attr_init(&sa, p, 0, 2, 3, z, c, r, g, b)) fill_convex(t1, 3, r, g, b, &sa);
+    }
+    return;
+  }
+
+  const span_attr_t *sp = NULL;
+  if (z)
+  {
+    if (!span_attr_init(&sa, p, 0, 1, 2, z, NULL, r, g, b) &&
+        !(n == 4 && span_attr_init(&sa, p, 0, 2, 3, z, NULL, r, g, b)))
+    {
+      return; // 화면에서 면적 0
+    }
+    sp = &sa;
+  }
+
+  if (n == 4 && quad_is_convex(p))
+  {
+    fill_convex(p, 4, r, g, b, sp);
+    return;
+  }
+
+  if (edge_function(p[0], p[1], p[2]) != 0) fill_convex(p, 3, r, g, b, sp);
+  if (n == 4)
+  {
+    vec2i_t t1[3] = {p[0], p[2], p[3]};
+    if (edge_function(p[0], p[2], p[3]) != 0) fill_convex(t1, 3, r, g, b, sp);
+  }
+}
+
+#if !CUBE_FIXED || defined(CUBE_BENCH)
 static void fill_face(const vertex_proj_t *proj,
                       const face_t *face,
                       uint8_t r, uint8_t g, uint8_t b)
 {
-  const vertex_proj_t *v0 = &proj[face->idx[0]];
-  const vertex_proj_t *v1 = &proj[face->idx[1]];
-  const vertex_proj_t *v2 = &proj[face->idx[2]];
-  const vertex_proj_t *v3 = &proj[face->idx[3]];
-
-  vec2i_t p0 = {v0->x, v0->y};
-  vec2i_t p1 = {v1->x, v1->y};
-  vec2i_t p2 = {v2->x, v2->y};
-  vec2i_t p3 = {v3->x, v3->y};
-
-  fill_triangle(p0, p1, p2, r, g, b);
-  fill_triangle(p0, p2, p3, r, g, b);
+  vec2i_t p[4];
+  for (int k = 0; k < 4; k++)
+  {
+    p[k].x = proj[face->idx[k]].x;
+    p[k].y = proj[face->idx[k]].y;
+  }
+  fill_poly(p, 4, r, g, b, NULL, NULL);
 }
+#endif
 
 //==================== 깊이 정렬(Painter) ====================//
 
 typedef struct
 {
-  uint8_t face_index;
-  float depth; // 이 면의 평균 z
+  uint16_t face_index;
+  int32_t depth; // 이 면의 평균 z (고정소수점 Q16, float 경로는 depth_key())
 } face_order_t;
 
+// 양수 float 는 비트 패턴(int32)의 대소가 값의 대소와 같아서 그대로 정렬 키로 씀 (z_cam > 0)
+static inline int32_t depth_key(float z)
+{
+  int32_t k;
+  memcpy(&k, &z, sizeof(k));
+  return k;
+}
+
+// 더 먼(더 큰 z) 면을 앞쪽에 배치
+// 삽입 정렬: 같은 깊이는 원래 순서 유지, 거의 정렬된 입력에서 O(n)
+// (mesh_prepare 는 painter 순서를 프레임 사이에 유지하므로 회전이 느리면 면마다 비교 한두 번)
+#ifdef CUBE_BENCH
+static uint32_t sort_faces, sort_moves; // 정렬한 면 수, 자리 옮긴 횟수
+#endif
+
 static void sort_faces_by_depth(face_order_t *order, int count)
 {
-  // 면 6개라 그냥 버블 정렬로 충분
-  for (int i = 0; i < count - 1; i++)
+#ifdef CUBE_BENCH
+  sort_faces += count;
+#endif
+  for (int i = 1; i < count; i++)
+  {
+    face_order_t t = order[i];
+    int j = i;
+    while (j > 0 && order[j - 1].depth < t.depth)
+    {
+      order[j] = order[j - 1];
+      j--;
+#ifdef CUBE_BENCH
+      sort_moves++;
+#endif
+    }
+    order[j] = t;
+  }
+}
+
+// 먼 면 n 개를 order[0 .. n-1] 로 (그 안의 순서는 상관없음), 나머지는 가까운 면
+// 정렬이 필요 없는 경로(볼록, z-buffer)에서 면 예산을 자를 때, 평균 O(count)
+static void select_far_faces(face_order_t *order, int count, int n)
+{
+  int lo = 0, hi = count - 1;
+  while (lo < hi)
   {
-    for (int j = 0; j < count - 1 - i; j++)
+    int32_t pivot = order[(lo + hi) >> 1].depth;
+    int i = lo, j = hi;
+    while (i <= j)
     {
-      // 더 먼(더 큰 z) 면을 앞쪽에 배치
-      if (order[j].depth < order[j + 1].depth)
+      while (order[i].depth > pivot) i++;
+      while (order[j].depth < pivot) j--;
+      if (i <= j)
       {
-        face_order_t tmp = order[j];
-        order[j] = order[j + 1];
-        order[j + 1] = tmp;
+        face_order_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+        i++;
+        j--;
       }
     }
+    // [lo..j] 는 pivot 이상, [i..hi] 는 pivot 이하: n 경계가 든 쪽만 계속
+    if (n <= j) hi = j;
+    else if (n >= i) lo = i;
+    else break;
   }
 }
 
+#if !CUBE_FIXED || defined(CUBE_BENCH)
+// float 경로의 면 그리기 방식 (CUBE_CULL)
+static uint8_t cube_cull = CUBE_CULL;
+#endif
+
 //==================== 회전 + 투영 ====================//
-// 0~1 float → 3비트 단계(0~7) → 다시 0~255 근사값
-static inline uint8_t quantize_3bit(float c)
+// 0~1 float → 0~255 (감마 보정/BAM 단계 변환은 패킹할 때 hub75_level() 에서)
+static inline uint8_t quantize_8bit(float c)
 {
   if (c < 0.0f) c = 0.0f;
   if (c > 1.0f) c = 1.0f;
 
-  int level = (int)(c * 7.0f + 0.5f); // 0~7
+  int level = (int)(c * 255.0f + 0.5f); // 0~255
 
-  // 완전 꺼진 면은 너무 칙칙하니 1단계 이상으로 올려서 전체적으로 화사하게
-  if (level < 1) level = 1;
-  if (level > 7) level = 7;
+  // 완전 꺼진 면은 너무 칙칙하니 최소 밝기(1/7) 이상으로 올려서 전체적으로 화사하게
+  if (level < 255 / 7) level = 255 / 7;
 
-  return (uint8_t)((level * 255) / 7);
+  return (uint8_t)level;
 }
 
-void render_cube_frame(float angleX, float angleY)
+#if !CUBE_FIXED || defined(CUBE_BENCH)
+static void render_cube_float(float angleX, float angleY)
 {
   vertex_proj_t proj[8];
+  vec3f_t cam[8]; // 카메라 기준 정점 (카메라 = 원점), 뒷면 판정용
 
   // ===== 1. 회전행렬 준비 (Y -> X) =====
   float cx = cosf(angleX);
@@ -248,6 +842,10 @@ void render_cube_frame(float angleX, float angleY)
     proj[i].x = sx_i;
     proj[i].y = sy_i;
     proj[i].z = z_cam;
+
+    cam[i].x = x2;
+    cam[i].y = y2;
+    cam[i].z = z_cam;
   }
 
   // ===== 3. 면 깊이 계산 (Painter용) =====
@@ -261,7 +859,7 @@ void render_cube_frame(float angleX, float angleY)
       zsum += proj[f->idx[k]].z;
     }
     order[i].face_index = (uint8_t)i;
-    order[i].depth = zsum * 0.25f;
+    order[i].depth = depth_key(zsum * 0.25f);
   }
 
   // ===== 4. 회전된 노멀(카메라 공간) 계산 =====
@@ -286,6 +884,23 @@ void render_cube_frame(float angleX, float angleY)
     face_normals_cam[i].z = z2;
   }
 
+  // ===== 4-1. 뒷면 제거 =====
+  // 면 위의 점 v 에서 n · v >= 0 이면 카메라를 등진 면 (원근이라 n.z 부호만으로는 가장자리 면을 잘못 판단)
+  int count = 6;
+  if (cube_cull)
+  {
+    count = 0;
+    for (int i = 0; i < 6; i++)
+    {
+      vec3f_t n = face_normals_cam[i];
+      vec3f_t v = cam[cube_faces[i].idx[0]];
+      if (n.x * v.x + n.y * v.y + n.z * v.z < 0.0f)
+      {
+        order[count++] = order[i];
+      }
+    }
+  }
+
   // ===== 5. 조명 세팅 =====
   // 위 + 약간 오른쪽에서 부드럽게 비추는 라이트
   vec3f_t light_dir = {0.4f, 0.8f, -0.4f};
@@ -313,9 +928,10 @@ void render_cube_frame(float angleX, float angleY)
 
   uint8_t shaded_r[6], shaded_g[6], shaded_b[6];
 
-  // ===== 6. 각 면에 대해 부드러운 라이팅 계산 =====
-  for (int i = 0; i < 6; i++)
+  // ===== 6. 각 면에 대해 부드러운 라이팅 계산 (그릴 면만) =====
+  for (int j = 0; j < count; j++)
   {
+    int i = order[j].face_index;
     vec3f_t n = face_normals_cam[i];
 
     // 노멀 정규화
@@ -350,16 +966,16 @@ void render_cube_frame(float angleX, float angleY)
     float bg = base_colors[i][1] * k;
     float bb = base_colors[i][2] * k;
 
-    // 3비트 단계에 맞춰 양자화 (0~1 → 0~7 → 0~255)
-    shaded_r[i] = quantize_3bit(br);
-    shaded_g[i] = quantize_3bit(bg);
-    shaded_b[i] = quantize_3bit(bb);
+    // 8비트로 양자화 (0~1 → 0~255), 패널 비트 깊이는 패킹 단계에서 결정
+    shaded_r[i] = quantize_8bit(br);
+    shaded_g[i] = quantize_8bit(bg);
+    shaded_b[i] = quantize_8bit(bb);
   }
 
-  // ===== 7. 깊이 순서대로 Painter 렌더링 =====
-  sort_faces_by_depth(order, 6);
+  // ===== 7. 깊이 순서대로 Painter 렌더링 (뒷면 제거 중이면 남은 면끼리 겹치지 않으므로 정렬 생략) =====
+  if (!cube_cull) sort_faces_by_depth(order, 6);
 
-  for (int i = 0; i < 6; i++)
+  for (int i = 0; i < count; i++)
   {
     int idx = order[i].face_index;
     fill_face(proj, &cube_faces[idx],
@@ -368,6 +984,383 @@ void render_cube_frame(float angleX, float angleY)
               shaded_b[idx]);
   }
 }
+#endif
+
+//==================== 고정소수점(Q16) 경로 ====================//
+// cosf/sinf → 사분면 sin 표 (xform.c), 정점마다 1/z → 역수 표 (선형 보간),
+// 회전/카메라/투영은 행렬 하나로 합쳐서 정점 배열을 한 번에 변환 (xform_batch)
+// 노멀은 돌리지 않고 조명 벡터와 카메라 위치를 모델 공간으로 거꾸로 돌림 → 면/꼭짓점마다 내적만
+
+// 1 / (1 + i/64), i = 0..64 (Q16)
+static const int32_t recip_q16[65] = {
+    65536, 64528, 63550, 62602, 61681, 60787, 59919, 59075, 58254, 57456,
+    56680, 55924, 55188, 54471, 53773, 53092, 52429, 51782, 51150, 50534,
+    49932, 49345, 48771, 48210, 47663, 47127, 46603, 46091, 45590, 45100,
+    44620, 44151, 43691, 43240, 42799, 42367, 41943, 41528, 41121, 40721,
+    40330, 39946, 39569, 39199, 38836, 38480, 38130, 37787, 37449, 37118,
+    36792, 36472, 36158, 35849, 35545, 35246, 34953, 34664, 34380, 34100,
+    33825, 33554, 33288, 33026, 32768,
+};
+
+// 1/z (z > 0, 둘 다 Q16): z = m × 2^e (m ∈ [1, 2)) 로 정규화해서 표 + 선형 보간, 상대 오차 < 1e-4
+static int32_t recip_q(int32_t z)
+{
+  int e = 15 - __builtin_clz((uint32_t)z); // 2^e <= z/Q16_ONE < 2^(e+1)
+  uint32_t m = (e >= 0) ? ((uint32_t)z >> e) : ((uint32_t)z << -e);
+  uint32_t i = (m - Q16_ONE) >> 10, f = m & 1023;
+  int32_t r = recip_q16[i] - (int32_t)(((recip_q16[i] - recip_q16[i + 1]) * f) >> 10);
+  return (e >= 0) ? (r >> e) : (r << -e);
+}
+
+// 정규화된 (0.4, 0.8, -0.4)
+static const int32_t light_q[3] = {26755, 53510, -26755};
+
+// 0~255 색 × 밝기 k (Q16), quantize_8bit() 과 같은 최소 밝기
+static inline uint8_t shade_q(uint8_t c, int32_t k)
+{
+  int32_t level = (c * k + Q16_ONE / 2) >> 16;
+  if (level < 255 / 7) level = 255 / 7;
+  if (level > 255) level = 255;
+  return (uint8_t)level;
+}
+
+// 모델 공간 노멀 (int8, 127 = 1) · 모델 공간 조명 → 밝기 k (Q16)
+// k = 0.60 + 0.35 × max(n·L, 0) 을 [0.55, 1] 로
+// 조명을 회전의 역으로 돌려 두었으므로 n·L 은 카메라 공간과 같음 (노멀 회전 없음)
+static int32_t light_k(const int8_t *n127, const int32_t *light)
+{
+  int32_t ndotl = (n127[0] * light[0] + n127[1] * light[1] + n127[2] * light[2]) / 127;
+  if (ndotl < 0) ndotl = 0;
+
+  int32_t k = 39322 + qmul(22938, ndotl);
+  if (k < 36045) k = 36045;
+  if (k > Q16_ONE) k = Q16_ONE;
+  return k;
+}
+
+//==================== 메시 ====================//
+
+// 큐브 (면 = 볼록 quad, 정점 ±1 을 그대로 Q16 배율 1 로)
+static const int8_t cube_mesh_verts[8 * 3] = {
+    -1, -1, -1, 1, -1, -1, 1, 1, -1, -1, 1, -1,
+    -1, -1, 1, 1, -1, 1, 1, 1, 1, -1, 1, 1};
+
+static const uint8_t cube_mesh_faces[6 * 4] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 0, 3, 7, 4, 1, 2, 6, 5, 3, 2, 6, 7, 0, 1, 5, 4};
+
+static const int8_t cube_mesh_normals[6 * 3] = {
+    0, 0, -127, 0, 0, 127, -127, 0, 0, 127, 0, 0, 0, 127, 0, 0, -127, 0};
+
+#if CUBE_GOURAUD || defined(CUBE_BENCH)
+// 꼭짓점 노멀 = 모서리 방향 (±1, ±1, ±1) / √3, CUBE_GOURAUD 일 때 면 안에서 밝기가 부드럽게 바뀜
+static const int8_t cube_mesh_vnormals[8 * 3] = {
+    -73, -73, -73, 73, -73, -73, 73, 73, -73, -73, 73, -73,
+    -73, -73, 73, 73, -73, 73, 73, 73, 73, -73, 73, 73};
+#endif
+
+// render_cube_float() 의 base_colors (n/7) × 255
+static const uint8_t cube_mesh_colors[6 * 3] = {
+    219, 109, 109, 109, 182, 109, 109, 146, 219, 219, 182, 109, 146, 182, 219, 182, 146, 219};
+
+const mesh_t mesh_cube = {
+    .v8 = cube_mesh_verts,
+    .i8 = cube_mesh_faces,
+    .normals = cube_mesh_normals,
+    .colors = cube_mesh_colors,
+#if CUBE_GOURAUD
+    .vnormals = cube_mesh_vnormals,
+#endif
+    .n_verts = 8,
+    .n_faces = 6,
+    .face_verts = 4,
+    .convex = CUBE_CULL,
+    .scale = Q16_ONE,
+};
+
+// 변환된 정점 (프레임마다 정점당 한 번)
+typedef struct
+{
+  int16_t x, y;   // 화면 좌표
+  int32_t w;      // 카메라에서 거리 (Q16, painter 깊이 키)
+#if RENDER_ZBUF
+  int32_t depth;  // z-buffer 깊이 (Q12)
+#endif
+  int32_t light;  // 꼭짓점 밝기 k (Q16, vnormals 가 있을 때)
+} vertex_q_t;
+
+static vertex_q_t mesh_vq[MESH_MAX_VERTS];
+static int32_t mesh_sx[MESH_MAX_VERTS], mesh_sy[MESH_MAX_VERTS], mesh_sz[MESH_MAX_VERTS]; // xform_batch 입출력 (SoA)
+static face_order_t mesh_order[MESH_MAX_FACES];
+// mesh_order 에 지난 프레임 면 전체 순서가 남아 있는 메시 (painter 경로만, 볼록이면 NULL)
+// 다음 프레임은 이 순서 그대로 깊이만 새로 구해서 정렬 → 삽입 정렬이 거의 정렬된 입력을 받음
+static const mesh_t *mesh_order_mesh;
+static uint16_t mesh_order_faces;
+
+static inline uint16_t mesh_index(const mesh_t *m, uint32_t i)
+{
+  return m->i8 ? m->i8[i] : m->i16[i];
+}
+
+static int32_t mesh_light[3]; // 모델 공간 조명 방향 (mesh_prepare)
+static uint8_t mesh_use_z;    // 이번 프레임 깊이 비교 여부
+
+// 면 깊이 키 = 꼭짓점 w 평균 (mesh_vq 가 이번 프레임 값일 때)
+static int32_t mesh_face_depth(const mesh_t *m, uint16_t i)
+{
+  uint32_t f = (uint32_t)i * m->face_verts;
+  int32_t zsum = 0;
+  for (uint8_t k = 0; k < m->face_verts; k++)
+  {
+    zsum += mesh_vq[mesh_index(m, f + k)].w;
+  }
+  return zsum / m->face_verts;
+}
+
+// 0 ~ 3 단계: 그릴 면을 mesh_order[first .. 반환값-1] 에 (그리는 순서대로)
+static uint16_t mesh_prepare(const mesh_t *m, float angleX, float angleY, uint16_t *first)
+{
+  const int32_t camera_z = 7 * Q16_ONE / 2; // 3.5, 모델은 |좌표| <= 1
+  const int32_t scale = 33;                 // 확대 배율
+
+  // ===== 0. 행렬: 투영 × 카메라 × 회전 (Y → X), 역회전으로 카메라/조명을 모델 공간에 =====
+  mat4_t rot, view, mvp, inv;
+  mat4_euler(&rot, angle_q(angleX), angle_q(angleY), 0);
+  mat4_translate(&view, 0, 0, camera_z);
+  mat4_mul(&view, &view, &rot);
+  mat4_project(&mvp, scale, SCREEN_W / 2, SCREEN_H / 2);
+  mat4_mul(&mvp, &mvp, &view);
+  mat4_inverse_rigid(&inv, &view);
+
+  const int32_t origin[3] = {0, 0, 0};
+  int32_t eye[3];
+  mat4_point(&inv, origin, eye);
+  mat4_dir(&inv, light_q, mesh_light);
+
+  // ===== 1. 정점 변환 (한 번에) + 원근 나눗셈 =====
+  for (uint16_t i = 0; i < m->n_verts; i++)
+  {
+    const uint32_t k = (uint32_t)i * 3;
+    mesh_sx[i] = (m->v8 ? m->v8[k] : m->v16[k]) * m->scale;
+    mesh_sy[i] = (m->v8 ? m->v8[k + 1] : m->v16[k + 1]) * m->scale;
+    mesh_sz[i] = (m->v8 ? m->v8[k + 2] : m->v16[k + 2]) * m->scale;
+  }
+  xform_batch(&mvp, mesh_sx, mesh_sy, mesh_sz, m->n_verts, mesh_sx, mesh_sy, mesh_sz);
+
+  for (uint16_t i = 0; i < m->n_verts; i++)
+  {
+    int32_t w = mesh_sz[i];
+    int32_t invz = recip_q(w);
+
+    vertex_q_t *q = &mesh_vq[i];
+    q->x = (int16_t)(qmul(mesh_sx[i], invz) >> 16);
+    q->y = (int16_t)(qmul(mesh_sy[i], invz) >> 16);
+    q->w = w;
+#if RENDER_ZBUF
+    // 1/z 를 [1/ZBUF_FAR, 1/ZBUF_NEAR] → [255, 0] 으로, 꼭짓점에서 잘라 두면 면 안쪽 보간도 범위 안
+    int32_t d = ((ZBUF_INV_NEAR - invz) * ZBUF_K) >> 8;
+    q->depth = (d < 0) ? 0 : (d > ZBUF_D_MAX) ? ZBUF_D_MAX : d;
+#endif
+    if (m->vnormals)
+    {
+      q->light = light_k(&m->vnormals[i * 3], mesh_light);
+    }
+  }
+
+  // ===== 2. 뒷면 제거 + 깊이 =====
+  // 면 위의 점 v 에서 n · (v - 눈) >= 0 이면 카메라를 등짐 (원근이라 n.z 부호만으로는 부족)
+  // 모델 공간에서 판정하므로 노멀을 돌리지 않음
+  uint16_t count = 0;
+  if (!m->convex && mesh_order_mesh == m && mesh_order_faces == m->n_faces)
+  {
+    // painter 는 면을 버리지 않으므로 면 집합이 그대로: 지난 순서에 깊이만 다시
+    for (; count < m->n_faces; count++)
+    {
+      mesh_order[count].depth = mesh_face_depth(m, mesh_order[count].face_index);
+    }
+  }
+  for (uint16_t i = count; i < m->n_faces; i++) // 다시 쓴 경우 count == n_faces 라서 건너뜀
+  {
+    uint32_t f = (uint32_t)i * m->face_verts;
+
+    if (m->convex)
+    {
+      const int8_t *n = &m->normals[i * 3];
+      uint32_t v = (uint32_t)mesh_index(m, f) * 3;
+      int64_t dot = 0;
+      for (uint8_t c = 0; c < 3; c++)
+      {
+        int32_t p = (m->v8 ? m->v8[v + c] : m->v16[v + c]) * m->scale;
+        dot += (int64_t)n[c] * (p - eye[c]);
+      }
+      if (dot >= 0) continue;
+    }
+
+    mesh_order[count].face_index = i;
+    mesh_order[count].depth = mesh_face_depth(m, i);
+    count++;
+  }
+  mesh_order_mesh = m->convex ? NULL : m;
+  mesh_order_faces = count;
+
+  // ===== 3. 깊이 정렬 (볼록이면 남은 면끼리 겹치지 않으므로, z-buffer 면 픽셀에서 가리므로 생략) =====
+  mesh_use_z = 0;
+#if RENDER_ZBUF
+  mesh_use_z = zbuf_on;
+#endif
+  *first = 0;
+  if (!m->convex && !mesh_use_z)
+  {
+    sort_faces_by_depth(mesh_order, count);
+  }
+  if (m->tri_budget && count > m->tri_budget)
+  {
+    // 예산을 넘으면 먼 면부터 버림: 정렬 안 한 경로는 먼 면만 앞으로 골라냄
+    *first = count - m->tri_budget;
+    if (m->convex || mesh_use_z) select_far_faces(mesh_order, count, *first);
+  }
+  return count;
+}
+
+// ===== 4. 조명 + 채우기 (면 하나) =====
+static void mesh_draw_face(const mesh_t *m, uint16_t i)
+{
+  uint32_t f = (uint32_t)i * m->face_verts;
+
+  const uint8_t *col = &m->colors[i * 3];
+  vec2i_t p[4];
+  int32_t z[4], vc[4][3];
+  for (uint8_t c = 0; c < m->face_verts; c++)
+  {
+    const vertex_q_t *q = &mesh_vq[mesh_index(m, f + c)];
+    p[c].x = q->x;
+    p[c].y = q->y;
+#if RENDER_ZBUF
+    z[c] = q->depth;
+#else
+    z[c] = 0;
+#endif
+    // Gouraud: 꼭짓점마다 면 색 × 꼭짓점 밝기, 스팬에서 Q12 로 보간 (+0.5 는 반올림)
+    for (uint8_t ch = 0; ch < 3 && m->vnormals; ch++)
+    {
+      vc[c][ch] = (shade_q(col[ch], q->light) << 12) + 2048;
+    }
+  }
+
+  if (m->vnormals)
+  {
+    fill_poly(p, m->face_verts, col[0], col[1], col[2], mesh_use_z ? z : NULL, (const int32_t(*)[3])vc);
+    return;
+  }
+
+  int32_t k = light_k(&m->normals[i * 3], mesh_light);
+  fill_poly(p, m->face_verts, shade_q(col[0], k), shade_q(col[1], k), shade_q(col[2], k), mesh_use_z ? z : NULL, NULL);
+}
+
+#if RENDER_FB
+uint16_t render_mesh(const mesh_t *m, float angleX, float angleY)
+{
+  if (m->n_verts > MESH_MAX_VERTS || m->n_faces > MESH_MAX_FACES) return 0;
+
+  uint16_t first;
+  uint16_t count = mesh_prepare(m, angleX, angleY, &first);
+  render_clear_wait(); // DMA 지우기는 정점 변환/정렬과 겹쳐서 돌고, 채우기 전에만 기다림
+  for (uint16_t j = first; j < count; j++)
+  {
+    mesh_draw_face(m, mesh_order[j].face_index);
+  }
+  return count - first;
+}
+#endif
+
+#if RENDER_BANDS
+static uint8_t mesh_yr[MESH_MAX_FACES][2]; // 그릴 면의 화면 row 범위 (mesh_order 순서, 화면 밖이면 lo > hi)
+
+uint16_t render_mesh_bands(const mesh_t *m, float angleX, float angleY,
+                           const uint8_t (*rows)[RENDER_BAND_ROWS], uint8_t n_bands, uint8_t n_rows,
+                           band_emit_t emit)
+{
+  if (m->n_verts > MESH_MAX_VERTS || m->n_faces > MESH_MAX_FACES || n_rows > RENDER_BAND_ROWS) return 0;
+
+  uint16_t first;
+  uint16_t count = mesh_prepare(m, angleX, angleY, &first);
+
+  // 면마다 화면 y 범위 → 밴드마다 row 몇 개와 비교해서 걸치는 면만 그림
+  for (uint16_t j = first; j < count; j++)
+  {
+    uint32_t f = (uint32_t)mesh_order[j].face_index * m->face_verts;
+    int y_lo = INT16_MAX, y_hi = INT16_MIN;
+    for (uint8_t c = 0; c < m->face_verts; c++)
+    {
+      int y = mesh_vq[mesh_index(m, f + c)].y;
+      if (y < y_lo) y_lo = y;
+      if (y > y_hi) y_hi = y;
+    }
+    if (y_lo < 0) y_lo = 0;
+    if (y_hi >= SCREEN_H) y_hi = SCREEN_H - 1;
+    if (y_lo > y_hi)
+    {
+      y_lo = 1;
+      y_hi = 0;
+    }
+    mesh_yr[j][0] = (uint8_t)y_lo;
+    mesh_yr[j][1] = (uint8_t)y_hi;
+  }
+
+  band_n = n_rows;
+  for (uint8_t band = 0; band < n_bands; band++)
+  {
+    // 지우기는 이 밴드 row 만
+    band_y = rows[band];
+    memset(band_buf, 0, n_rows * sizeof(row_t));
+#if RENDER_ZBUF
+    if (mesh_use_z) memset(band_z, 0xFF, sizeof(band_z));
+#endif
+
+    for (uint16_t j = first; j < count; j++)
+    {
+      uint8_t hit = 0;
+      for (uint8_t k = 0; k < n_rows && !hit; k++)
+      {
+        hit = band_y[k] >= mesh_yr[j][0] && band_y[k] <= mesh_yr[j][1];
+      }
+      if (hit) mesh_draw_face(m, mesh_order[j].face_index);
+    }
+    emit(band, band_buf);
+  }
+  band_n = 0;
+  return count - first;
+}
+
+void render_cube_bands(float angleX, float angleY,
+                       const uint8_t (*rows)[RENDER_BAND_ROWS], uint8_t n_bands, uint8_t n_rows,
+                       band_emit_t emit)
+{
+  render_mesh_bands(&mesh_cube, angleX, angleY, rows, n_bands, n_rows, emit);
+}
+#endif
+
+#if RENDER_FB
+#ifdef CUBE_BENCH
+static uint8_t render_float; // 1: float 경로
+#endif
+
+void render_cube_frame(float angleX, float angleY)
+{
+#ifdef CUBE_BENCH
+  if (render_float)
+  {
+    render_cube_float(angleX, angleY);
+    return;
+  }
+#endif
+#if CUBE_FIXED || defined(CUBE_BENCH)
+  render_mesh(&mesh_cube, angleX, angleY);
+#else
+  render_clear_wait();
+  render_cube_float(angleX, angleY);
+#endif
+}
+#endif
 // void render_cube_frame(float angleX, float angleY)
 // {
 //     vertex_proj_t proj[8];
@@ -543,4 +1536,359 @@ void render_cube_frame(float angleX, float angleY)
 //                   shaded_g[idx],
 //                   shaded_b[idx]);
 //     }
-// }
\ No newline at end of file
+// }
+
+#ifdef CUBE_BENCH
+// 호스트 벤치마크: 삼각형 두 개 edge_function 채우기 vs 볼록 quad 스팬 채우기
+//   gcc -O2 -DCUBE_BENCH 3d.c xform.c -lm -o cube_bench
+// 버튼을 누르고 있을 때와 같은 각도 간격으로 한 바퀴 이상 돌리면서 프레임마다 fb 가 같은지 확인
+// -DRENDER_ZBUF=1 을 붙이면 painter vs z-buffer 도 큐브 / 토러스로 비교
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#define BENCH_FRAMES 2000
+
+static row_t fb_ref[SCREEN_H], fb_q[SCREEN_H];
+
+static double now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 한 프레임 시간 (us) 누적, fb 는 그대로 남김 (render_float 이면 float 큐브)
+static double bench_frame(const mesh_t *m, float ax, float ay)
+{
+  clear_framebuffer();
+  double t0 = now_us();
+  if (render_float) render_cube_frame(ax, ay);
+  else render_mesh(m, ax, ay);
+  return now_us() - t0;
+}
+
+// fb 의 r 채널에 쓰인 서로 다른 값 수
+static int count_levels(const row_t *f)
+{
+  uint8_t seen[256] = {0};
+  int n = 0;
+  for (int y = 0; y < SCREEN_H; y++)
+    for (int x = 0; x < SCREEN_W; x++)
+      if (!seen[f[y].r[x]]++) n++;
+  return n;
+}
+
+// fb 전체 FNV-1a (두 번 돌린 결과 비교용)
+static uint32_t fb_hash(void)
+{
+  const uint8_t *p = (const uint8_t *)fb;
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < sizeof(fb); i++)
+    h = (h ^ p[i]) * 16777619u;
+  return h;
+}
+
+// 더티 사각형: 전체 지우기 vs 지난번에 그린 사각형만 (프레임마다 fb 가 같아야 함)
+// 다시 패킹할 사각형 (지난 + 이번) 의 평균 크기도 (패킹 비용은 주소 수 × 컬럼 수에 비례)
+static void bench_dirty(void)
+{
+  static uint32_t hash[BENCH_FRAMES];
+  double t_full = 0, t_dirty = 0;
+  long rows = 0, cols = 0;
+  int diff = 0;
+
+  for (int f = 0; f < BENCH_FRAMES; f++)
+  {
+    double t0 = now_us();
+    clear_framebuffer();
+    render_mesh(&mesh_cube, 0.015f * f, 0.021f * f);
+    t_full += now_us() - t0;
+    hash[f] = fb_hash();
+  }
+
+  clear_framebuffer();
+  for (int f = 0; f < BENCH_FRAMES; f++)
+  {
+    double t0 = now_us();
+    clear_framebuffer_dirty();
+    render_mesh(&mesh_cube, 0.015f * f, 0.021f * f);
+    t_dirty += now_us() - t0;
+    diff += fb_hash() != hash[f];
+
+    fb_rect_t r = render_dirty_rect();
+    rows += r.y1 - r.y0 + 1;
+    cols += r.x1 - r.x0 + 1;
+  }
+
+  printf("dirty rect, %d frames\n", BENCH_FRAMES);
+  printf("  clear all + render    : %8.2f us/frame\n", t_full / BENCH_FRAMES);
+  printf("  clear rect + render   : %8.2f us/frame  (x%.2f), %d frames differ\n", t_dirty / BENCH_FRAMES,
+         t_full / t_dirty, diff);
+  printf("  repack rect           : %.1f rows x %.1f cols (of %d x %d)\n", (double)rows / BENCH_FRAMES,
+         (double)cols / BENCH_FRAMES, SCREEN_H, SCREEN_W);
+}
+
+#if RENDER_ZBUF || RENDER_BANDS
+// 토러스 (R 0.7, r 0.3, 16 × 8 quad): 오목해서 뒷면 제거만으로는 안 되고 정렬이나 깊이 비교가 필요
+#define TORUS_U 16
+#define TORUS_V 8
+static int16_t torus_v[TORUS_U * TORUS_V * 3];
+static uint8_t torus_i[TORUS_U * TORUS_V * 4];
+static int8_t torus_n[TORUS_U * TORUS_V * 3];
+static uint8_t torus_c[TORUS_U * TORUS_V * 3];
+
+static mesh_t torus_mesh(void)
+{
+  for (int u = 0; u < TORUS_U; u++)
+  {
+    for (int v = 0; v < TORUS_V; v++)
+    {
+      int i = u * TORUS_V + v;
+      float a = 6.2831853f * u / TORUS_U, b = 6.2831853f * v / TORUS_V;
+      float rr = 0.7f + 0.3f * cosf(b);
+      torus_v[i * 3 + 0] = (int16_t)lrintf(rr * cosf(a) * 16384);
+      torus_v[i * 3 + 1] = (int16_t)lrintf(0.3f * sinf(b) * 16384);
+      torus_v[i * 3 + 2] = (int16_t)lrintf(rr * sinf(a) * 16384);
+
+      // 면 중심 방향 노멀, 바깥에서 봤을 때 quad 감김은 상관없음 (fill_convex)
+      float am = a + 3.14159265f / TORUS_U, bm = b + 3.14159265f / TORUS_V;
+      torus_n[i * 3 + 0] = (int8_t)lrintf(cosf(bm) * cosf(am) * 127);
+      torus_n[i * 3 + 1] = (int8_t)lrintf(sinf(bm) * 127);
+      torus_n[i * 3 + 2] = (int8_t)lrintf(cosf(bm) * sinf(am) * 127);
+
+      int u1 = (u + 1) % TORUS_U, v1 = (v + 1) % TORUS_V;
+      torus_i[i * 4 + 0] = (uint8_t)i;
+      torus_i[i * 4 + 1] = (uint8_t)(u1 * TORUS_V + v);
+      torus_i[i * 4 + 2] = (uint8_t)(u1 * TORUS_V + v1);
+      torus_i[i * 4 + 3] = (uint8_t)(u * TORUS_V + v1);
+
+      torus_c[i * 3 + 0] = (u & 1) ? 230 : 90;
+      torus_c[i * 3 + 1] = (v & 1) ? 200 : 120;
+      torus_c[i * 3 + 2] = 150;
+    }
+  }
+
+  mesh_t m = {0};
+  m.v16 = torus_v;
+  m.i8 = torus_i;
+  m.normals = torus_n;
+  m.colors = torus_c;
+  m.n_verts = TORUS_U * TORUS_V;
+  m.n_faces = TORUS_U * TORUS_V;
+  m.face_verts = 4;
+  m.convex = 0;
+  m.scale = 4; // 16384 × 4 = Q16 1.0
+  return m;
+}
+#endif
+
+#if RENDER_ZBUF
+// 메시 하나를 painter / z-buffer 로 (clear 포함) 돌려서 시간과 차이 픽셀 수
+static void bench_zbuf_mesh(const char *name, const mesh_t *m)
+{
+  double t_p = 0, t_z = 0;
+  long px = 0;
+  sort_faces = sort_moves = 0;
+
+  for (int f = 0; f < BENCH_FRAMES; f++)
+  {
+    float ax = 0.015f * f, ay = 0.021f * f;
+
+    render_set_zbuf(0);
+    double t0 = now_us();
+    clear_framebuffer();
+    render_mesh(m, ax, ay);
+    double t1 = now_us();
+    memcpy(fb_ref, fb, sizeof(fb));
+
+    render_set_zbuf(1);
+    double t2 = now_us();
+    clear_framebuffer();
+    render_mesh(m, ax, ay);
+    double t3 = now_us();
+
+    t_p += t1 - t0;
+    t_z += t3 - t2;
+    const uint8_t *p = (const uint8_t *)fb, *q = (const uint8_t *)fb_ref;
+    for (size_t i = 0; i < sizeof(fb); i++)
+      px += p[i] != q[i];
+  }
+  render_set_zbuf(0);
+
+  printf("  %-6s painter        : %8.2f us/frame (clear 포함), sort %.2f moves/face\n", name, t_p / BENCH_FRAMES,
+         (double)sort_moves / sort_faces);
+  printf("  %-6s z-buffer       : %8.2f us/frame  (x%.2f), %.2f bytes/frame differ\n", name,
+         t_z / BENCH_FRAMES, t_p / t_z, (double)px / BENCH_FRAMES);
+}
+
+static void bench_zbuf(void)
+{
+  double t_c[2];
+  for (int z = 0; z < 2; z++)
+  {
+    render_set_zbuf(z);
+    double t0 = now_us();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+      clear_framebuffer();
+    t_c[z] = (now_us() - t0) / BENCH_FRAMES;
+  }
+
+  mesh_t cube = mesh_cube, torus = torus_mesh();
+  cube.convex = 0;
+
+  printf("z-buffer (%u bytes), %d frames\n", (unsigned)sizeof(zbuf), BENCH_FRAMES);
+  printf("  clear fb / fb + z      : %8.2f / %.2f us\n", t_c[0], t_c[1]);
+  bench_zbuf_mesh("cube", &cube);
+  bench_zbuf_mesh("torus", &torus);
+}
+#endif
+
+#if RENDER_BANDS
+// 1/16 스캔 기본 배치: 주소 a 의 row = a, a+16, a+32, a+48 (보드에서는 hub75_band_rows() 로)
+// 밴드 b 는 주소 b × RENDER_BAND_ADDRS 부터 RENDER_BAND_ADDRS 개
+#define BENCH_BANDS (16 / RENDER_BAND_ADDRS)
+static uint8_t bench_band_y[BENCH_BANDS][RENDER_BAND_ROWS];
+
+static void bench_emit(uint8_t band, const row_t *rows)
+{
+  for (uint8_t j = 0; j < RENDER_BAND_ROWS; j++)
+  {
+    fb_q[bench_band_y[band][j]] = rows[j];
+  }
+}
+
+// fb 경로 (clear + render_mesh) vs 밴드 경로, 결과가 같은지와 시간
+static void bench_bands_mesh(const char *name, const mesh_t *m, uint8_t z)
+{
+  double t_fb = 0, t_band = 0;
+  int diff = 0;
+
+  render_set_zbuf(z);
+  for (int f = 0; f < BENCH_FRAMES; f++)
+  {
+    float ax = 0.015f * f, ay = 0.021f * f;
+
+    double t0 = now_us();
+    clear_framebuffer();
+    render_mesh(m, ax, ay);
+    double t1 = now_us();
+    render_mesh_bands(m, ax, ay, (const uint8_t(*)[RENDER_BAND_ROWS])bench_band_y, BENCH_BANDS, RENDER_BAND_ROWS,
+                      bench_emit);
+    double t2 = now_us();
+
+    t_fb += t1 - t0;
+    t_band += t2 - t1;
+    diff += memcmp(fb_q, fb, sizeof(fb)) != 0;
+  }
+  render_set_zbuf(0);
+
+  printf("  %-8s%s fb / bands : %8.2f / %.2f us/frame  (x%.2f), %d frames differ\n", name, z ? " z" : "  ",
+         t_fb / BENCH_FRAMES, t_band / BENCH_FRAMES, t_fb / t_band, diff);
+}
+
+static void bench_bands(void)
+{
+  for (int a = 0; a < 16; a++)
+    for (int j = 0; j < 4; j++)
+      bench_band_y[a / RENDER_BAND_ADDRS][(a % RENDER_BAND_ADDRS) * 4 + j] = (uint8_t)(a + 16 * j);
+
+  mesh_t flat = mesh_cube, painter = mesh_cube, torus = torus_mesh();
+  flat.vnormals = NULL;
+  painter.vnormals = NULL;
+  painter.convex = 0;
+
+  // 밴드 쪽 RAM: 밴드 row + 면 row 범위 (+ hub75_map.c 의 밴드 오프셋 표 1536바이트)
+  unsigned ram_fb = sizeof(fb), ram_band = sizeof(band_buf) + sizeof(mesh_yr);
+#if RENDER_ZBUF
+  ram_fb += sizeof(zbuf);
+  ram_band += sizeof(band_z);
+#endif
+  printf("bands (%d x %d rows), %d frames, fb %u bytes vs band %u bytes\n", BENCH_BANDS, RENDER_BAND_ROWS, BENCH_FRAMES,
+         ram_fb, ram_band);
+  bench_bands_mesh("flat", &flat, 0);
+  bench_bands_mesh("gouraud", &mesh_cube, 0);
+  bench_bands_mesh("painter", &painter, 0);
+  bench_bands_mesh("torus", &torus, 0);
+#if RENDER_ZBUF
+  bench_bands_mesh("torus", &torus, 1);
+#endif
+}
+#endif
+
+int main(void)
+{
+  double t_ref = 0, t_span = 0, t_float = 0, t_painter = 0, t_gouraud = 0;
+  int diff = 0, diff_float = 0, diff_painter = 0;
+  long px_float = 0, px_painter = 0, levels_flat = 0, levels_gouraud = 0;
+  mesh_t flat = mesh_cube, painter = mesh_cube, gouraud = mesh_cube;
+  flat.vnormals = NULL;
+  painter.vnormals = NULL;
+  painter.convex = 0;
+  gouraud.vnormals = cube_mesh_vnormals;
+
+  for (int f = 0; f < BENCH_FRAMES; f++)
+  {
+    float ax = 0.015f * f, ay = 0.021f * f;
+
+    // 채우기: edge function vs 스팬 (같은 고정소수점 변환 위에서, 픽셀 동일해야 함)
+    fill_ref = 1;
+    t_ref += bench_frame(&flat, ax, ay);
+    memcpy(fb_ref, fb, sizeof(fb));
+    fill_ref = 0;
+    t_span += bench_frame(&flat, ax, ay);
+    diff += memcmp(fb_ref, fb, sizeof(fb)) != 0;
+    memcpy(fb_q, fb, sizeof(fb));
+
+    // 변환/조명: float vs Q16 (반올림 차이로 경계 픽셀/밝기 1 단계 정도는 다를 수 있음)
+    // 큐브 메시 색은 8비트라서 float 경로의 n/7 색과 0.5 단계 안쪽으로 다름
+    render_float = 1;
+    t_float += bench_frame(&flat, ax, ay);
+    render_float = 0;
+    const uint8_t *p = (const uint8_t *)fb, *q = (const uint8_t *)fb_q;
+    if (memcmp(fb_q, fb, sizeof(fb)))
+    {
+      diff_float++;
+      for (size_t i = 0; i < sizeof(fb); i += 1)
+        px_float += p[i] != q[i];
+    }
+
+    // 뒷면 제거 vs painter (보이는 면끼리 맞닿은 모서리 픽셀은 그리는 순서에 따라 색이 다를 수 있음)
+    clear_framebuffer();
+    double t4 = now_us();
+    render_mesh(&painter, ax, ay);
+    t_painter += now_us() - t4;
+    if (memcmp(fb_q, fb, sizeof(fb)))
+    {
+      diff_painter++;
+      for (size_t i = 0; i < sizeof(fb); i += 1)
+        px_painter += p[i] != q[i];
+    }
+
+    // 면마다 한 색 vs Gouraud: 시간과 화면에 쓰인 서로 다른 r 값 수 (패널 색 단계를 얼마나 쓰는지)
+    t_gouraud += bench_frame(&gouraud, ax, ay);
+    levels_flat += count_levels(fb_q);
+    levels_gouraud += count_levels(fb);
+  }
+
+  printf("render_cube_frame, %d frames\n", BENCH_FRAMES);
+  printf("  float + span quad     : %8.2f us/frame\n", t_float / BENCH_FRAMES);
+  printf("  Q16 + edge function   : %8.2f us/frame\n", t_ref / BENCH_FRAMES);
+  printf("  Q16 + span quad       : %8.2f us/frame  (x%.1f vs edge)\n", t_span / BENCH_FRAMES, t_ref / t_span);
+  printf("  span vs edge          : %d frames differ\n", diff);
+  printf("  Q16 + span, painter   : %8.2f us/frame  (cull x%.2f)\n", t_painter / BENCH_FRAMES, t_painter / t_span);
+  printf("  float vs Q16          : %d frames differ, %.2f bytes/frame\n", diff_float, (double)px_float / BENCH_FRAMES);
+  printf("  cull vs painter       : %d frames differ, %.2f bytes/frame\n", diff_painter, (double)px_painter / BENCH_FRAMES);
+  printf("  Q16 + span, Gouraud   : %8.2f us/frame  (flat x%.2f)\n", t_gouraud / BENCH_FRAMES, t_gouraud / t_span);
+  printf("  r levels flat/Gouraud : %.1f / %.1f per frame\n", (double)levels_flat / BENCH_FRAMES,
+         (double)levels_gouraud / BENCH_FRAMES);
+  bench_dirty();
+#if RENDER_ZBUF
+  bench_zbuf();
+#endif
+#if RENDER_BANDS
+  bench_bands();
+#endif
+  return diff ? 1 : 0;
+}
+#endif
@@ -16,8 +16,157 @@ typedef struct
 } row_t;
 #endif
 
+// 1: 변환/조명을 Q16 고정소수점 + sin/역수 표로 (libm 호출 없음), 0: 기존 float 경로
+#ifndef CUBE_FIXED
+#define CUBE_FIXED 1
+#endif
+
+// 1: 카메라를 등진 면은 버리고 깊이 정렬 없이 그림 (볼록한 물체 전용, 큐브는 최대 3면)
+// 0: 모든 면을 깊이 정렬해서 먼 면부터 덮어 그림 (painter, 오목한 물체용)
+#ifndef CUBE_CULL
+#define CUBE_CULL 1
+#endif
+
+// 1: 큐브를 꼭짓점 조명 + 스팬 색 보간 (Gouraud) 으로, 0: 면마다 한 색
+#ifndef CUBE_GOURAUD
+#define CUBE_GOURAUD 1
+#endif
+
+// 1: 64×64 uint8 깊이 버퍼(4KB RAM)를 넣고 render_set_zbuf() 로 장면마다 켤 수 있게
+//    켜면 정렬 없이 픽셀 단위 깊이 비교 (겹치는 오목한 물체, 면이 많아 정렬이 비쌀 때)
+// 0: 깊이 버퍼 없음, 정렬/뒷면 제거만
+#ifndef RENDER_ZBUF
+#define RENDER_ZBUF 0
+#endif
+
+// 1: fb(12KB) 없이 스캔 주소(밴드)마다 그 주소가 쓰는 row 만 그려서 바로 패킹 (render_mesh_bands)
+//    지우기도 밴드 row 만 (fb 전체 clear 없음), CUBE_FIXED=1 전용
+//    hub75_map.c 도 밴드 표가 있어야 하므로 헤더를 고치지 말고 빌드 옵션 -DRENDER_BANDS=1 로
+// 0: 기존 fb 에 다 그린 뒤 hub75_pack_frame() 으로 패킹
+#ifndef RENDER_BANDS
+#define RENDER_BANDS 0
+#endif
+// 밴드 하나에 묶는 스캔 주소 수: 면을 밴드마다 다시 세팅하므로 크게 하면 빨라지고 RAM 은 주소당 768바이트
+#ifndef RENDER_BAND_ADDRS
+#define RENDER_BAND_ADDRS 1
+#endif
+#define RENDER_BAND_ROWS (4 * RENDER_BAND_ADDRS) // 밴드 하나의 row 수 상한 (주소당 64 row / 1/16 스캔)
+
+// 1: clear_framebuffer() / clear_framebuffer_dirty() 가 DMA2 메모리 채우기 (blit.c) 를 걸고 바로 반환
+//    render_mesh() 는 정점 변환/정렬을 하는 동안 지우기가 돌게 두고 채우기 직전에 기다림
+//    fb 를 직접 쓰는 쪽 (레이어 모드) 은 render_clear_wait() 뒤에
+// 호스트 벤치 빌드는 CPU memset 그대로
+#ifndef RENDER_DMA_CLEAR
+#if defined(HOST_BUILD) || defined(CUBE_BENCH)
+#define RENDER_DMA_CLEAR 0
+#else
+#define RENDER_DMA_CLEAR 1
+#endif
+#endif
+
+// 1: put_pixel() / fb_hline() 이 팔레트 fb (fbpal.c) 에도 그릴 수 있게 (render_set_format)
+// 호스트 벤치 빌드는 3d.c 만으로 링크되게 RGB fb 만
+#ifndef RENDER_FBPAL
+#if defined(HOST_BUILD) || defined(CUBE_BENCH)
+#define RENDER_FBPAL 0
+#else
+#define RENDER_FBPAL 1
+#endif
+#endif
+
+// 1: put_pixel() / fb_hline() 이 스캔 버퍼 (bitfb.c) 에 바로 그릴 수 있게 (FB_BITPLANE)
+#ifndef RENDER_BITFB
+#if defined(HOST_BUILD) || defined(CUBE_BENCH)
+#define RENDER_BITFB 0
+#else
+#define RENDER_BITFB 1
+#endif
+#endif
+
+// 깊이 버퍼 범위 (카메라 거리, 모델 |좌표| <= 1 + 카메라 3.5 기준), 밖은 끝값으로 붙음
+#define ZBUF_NEAR 1.5f
+#define ZBUF_FAR 5.5f
+
+// 플래시에 두는 메시 (obj2mesh.c 가 OBJ 에서 만들어 줌)
+// 모델 좌표 = 정점 정수값 × scale (Q16), |좌표| <= 1 로 정규화되어 있어야 화면에 맞음
+// 면 i 의 정점 인덱스는 [i × face_verts ...], 노멀은 127 = 1.0, 색은 0~255 (조명 전)
+typedef struct
+{
+  const int8_t *v8;       // 정점 xyz (int8), 또는
+  const int16_t *v16;     // 정점 xyz (int16), 둘 중 하나만
+  const uint8_t *i8;      // 면 정점 인덱스 (정점 256개 이하), 또는
+  const uint16_t *i16;    // 면 정점 인덱스
+  const int8_t *normals;  // 면 노멀 xyz (모델 공간, 단위 길이)
+  const uint8_t *colors;  // 면 색 rgb
+  const int8_t *vnormals; // 꼭짓점 노멀 xyz (Gouraud), NULL 이면 면 노멀로 면마다 한 색
+  uint16_t n_verts;
+  uint16_t n_faces;
+  uint8_t face_verts;     // 면당 정점 수 (3: 삼각형, 4: 볼록 quad)
+  uint8_t convex;         // 1: 뒷면 제거 + 정렬 없음, 0: painter (오목한 물체)
+  uint16_t tri_budget;    // 프레임당 그릴 면 수 상한 (0: 제한 없음), 넘으면 먼 면부터 버림
+  int32_t scale;          // 정점 정수값 → 모델 좌표 (Q16)
+} mesh_t;
+
+#define MESH_MAX_VERTS 256 // 정점 변환 캐시 (24바이트/정점, RENDER_ZBUF 면 28)
+#define MESH_MAX_FACES 512 // 면 정렬 배열 (8바이트/면)
+
+extern const mesh_t mesh_cube;
+
+// fb 사각형 (양 끝 포함), x0 > x1 또는 y0 > y1 이면 빈 사각형
+typedef struct
+{
+  int16_t x0, y0, x1, y1;
+} fb_rect_t;
+
+static inline fb_rect_t fb_rect_union(fb_rect_t a, fb_rect_t b)
+{
+  if (a.x0 > a.x1 || a.y0 > a.y1) return b;
+  if (b.x0 > b.x1 || b.y0 > b.y1) return a;
+  fb_rect_t r = {(a.x0 < b.x0) ? a.x0 : b.x0, (a.y0 < b.y0) ? a.y0 : b.y0,
+                 (a.x1 > b.x1) ? a.x1 : b.x1, (a.y1 > b.y1) ? a.y1 : b.y1};
+  return r;
+}
+
+#if !RENDER_BANDS || defined(CUBE_BENCH)
 extern row_t fb[SCREEN_H]; // frame buffer
 void render_cube_frame(float angleX, float angleY);
-void clear_framebuffer(void);
+uint16_t render_mesh(const mesh_t *m, float angleX, float angleY); // 그린 면 수 반환
+void clear_framebuffer(void); // z-buffer 가 켜져 있으면 같이 지움
+void render_clear_wait(void); // 걸어 둔 DMA 지우기가 끝날 때까지 (RENDER_DMA_CLEAR=0 이면 바로 반환)
+
+// 더티 사각형: 면 채우기가 그린 영역의 바운딩 박스를 프레임마다 모아 둠
+// clear_framebuffer_dirty() 는 지난 프레임에 그린 사각형만 지우고,
+// render_dirty_rect() 는 지난 프레임 + 이번 프레임 사각형 (바뀌었을 수 있는 곳 = 다시 패킹할 곳)
+// fb 에 직접 쓴 뒤 (레이어 모드 등) 에는 clear_framebuffer() 로 한 번 전체를 지우고 시작
+void clear_framebuffer_dirty(void);
+fb_rect_t render_dirty_rect(void);
+#endif
+#if RENDER_BANDS
+// 밴드 b 를 다 그릴 때마다 호출, rows[j] = 화면 row band_y[b][j] 의 내용
+typedef void (*band_emit_t)(uint8_t band, const row_t *rows);
+
+// 밴드 b 의 row 번호 band_y[b][0 .. n_rows-1] (밴드끼리 겹치지 않게) 만 그려서 밴드마다 emit
+// 면은 화면 y 범위가 밴드 row 에 걸칠 때만 그리고, 결과는 fb 경로와 바이트 단위로 같음
+uint16_t render_mesh_bands(const mesh_t *m, float angleX, float angleY,
+                           const uint8_t (*band_y)[RENDER_BAND_ROWS], uint8_t n_bands, uint8_t n_rows,
+                           band_emit_t emit); // 그린 면 수 반환
+void render_cube_bands(float angleX, float angleY,
+                       const uint8_t (*band_y)[RENDER_BAND_ROWS], uint8_t n_bands, uint8_t n_rows,
+                       band_emit_t emit);
+#endif
+void render_set_zbuf(uint8_t on); // 1: 깊이 버퍼로 그림 (RENDER_ZBUF=0 이면 무시)
+
+// 2D 그리기 (put_pixel, fb_hline) 대상 형식, 메시 렌더는 항상 RGB fb (Gouraud 라 팔레트에 안 맞음)
+typedef enum
+{
+  FB_RGB,      // fb (row_t), color = 0xRRGGBB (RENDER_BANDS 빌드는 fb 가 없어서 아무것도 안 함)
+  FB_INDEXED,  // fbpal (fbpal.h), color = 팔레트 번호 (RENDER_FBPAL=1)
+  FB_BITPLANE, // bitfb_target() 의 스캔 버퍼 (bitfb.h), color = 0xRRGGBB (RENDER_BITFB=1)
+} fb_format_t;
+
+void render_set_format(fb_format_t f);
+fb_format_t render_get_format(void);
+void put_pixel(int x, int y, uint32_t color);
+void fb_hline(int x0, int x1, int y, uint32_t color); // x0 ~ x1 (양 끝 포함), 화면 밖은 자름
 
 #endif
\ No newline at end of file
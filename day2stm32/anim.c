@@ -0,0 +1,116 @@
+#include "anim.h"
+#include "prof.h"
+
+#ifndef HOST_BUILD
+#include "main.h"
+
+// HAL tick (1kHz, SysTick 인터럽트) + SysTick->VAL (다운 카운터) 로 us
+// 스캔 인터럽트가 SysTick 보다 우선이라 VAL 이 이미 한 바퀴 돌았는데 tick 은 아직일 수 있음
+// → PENDSTSET 이 서 있으면 VAL 을 다시 읽고 1ms 를 더함
+uint32_t anim_now_us(void)
+{
+  uint32_t ms, val;
+  uint32_t load = SysTick->LOAD + 1;
+
+  do
+  {
+    ms = HAL_GetTick();
+    val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+      val = SysTick->VAL;
+      ms++;
+    }
+  } while (ms != HAL_GetTick() && !(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk));
+
+  return ms * 1000u + (load - val) * 1000u / load;
+}
+#else
+#include <time.h>
+
+uint32_t anim_now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+#endif
+
+void anim_init(anim_clock_t *c)
+{
+  c->last_us = anim_now_us();
+  c->acc_us = 0;
+  c->window_us = c->last_us;
+  c->frames = 0;
+  c->steps = 0;
+}
+
+uint8_t anim_update(anim_clock_t *c)
+{
+  uint32_t now = anim_now_us();
+  uint8_t n = 0;
+
+  c->acc_us += now - c->last_us;
+  c->last_us = now;
+  while (c->acc_us >= ANIM_STEP_US && n < ANIM_MAX_STEPS)
+  {
+    c->acc_us -= ANIM_STEP_US;
+    n++;
+  }
+  if (n == ANIM_MAX_STEPS) c->acc_us = 0; // 밀린 시간은 버림 (느려질 뿐 튀지 않음)
+  c->steps += n;
+
+  // 1초마다 실측값 갱신
+  uint32_t win = now - c->window_us;
+  if (win >= 1000000u)
+  {
+    prof_stats.draw_fps = (uint32_t)((uint64_t)c->frames * 1000000u / win);
+    prof_stats.sim_hz = (uint32_t)((uint64_t)c->steps * 1000000u / win);
+    c->window_us = now;
+    c->frames = 0;
+    c->steps = 0;
+  }
+  return n;
+}
+
+void anim_frame(anim_clock_t *c) { c->frames++; }
+
+#ifdef ANIM_MAIN
+// 호스트 확인: 프레임마다 렌더 시간이 들쭉날쭉해도 초당 스텝 수(= 회전 속도)가 ANIM_HZ 로 유지되는지
+//   gcc -O2 -DHOST_BUILD -DANIM_MAIN anim.c prof.c hub75.c hub75_rec.c -o anim && ./anim
+#include <stdio.h>
+
+static void busy_us(uint32_t us)
+{
+  uint32_t t0 = anim_now_us();
+  while (anim_now_us() - t0 < us)
+  {
+  }
+}
+
+int main(void)
+{
+  static const uint32_t render_us[] = {2000, 9000, 25000}; // 500 / 111 / 40 fps 정도
+  prof_init();
+
+  for (uint8_t k = 0; k < 3; k++)
+  {
+    anim_clock_t c;
+    float angle = 0;
+    anim_init(&c);
+    uint32_t t0 = anim_now_us();
+
+    while (anim_now_us() - t0 < 2100000u)
+    {
+      uint8_t n = anim_update(&c);
+      for (uint8_t i = 0; i < n; i++) angle += 0.9f * ANIM_DT; // 0.9 rad/s
+      busy_us(render_us[k] + (k * 1237u * c.frames) % 3000u);
+      anim_frame(&c);
+    }
+    printf("render ~%5lu us: draw %3lu fps, sim %3lu Hz, angle %.3f rad after %.2f s (expect %.3f)\n",
+           (unsigned long)render_us[k], (unsigned long)prof_stats.draw_fps, (unsigned long)prof_stats.sim_hz,
+           angle, (anim_now_us() - t0) / 1e6, 0.9 * (anim_now_us() - t0) / 1e6);
+  }
+  return 0;
+}
+#endif
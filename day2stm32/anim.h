@@ -0,0 +1,35 @@
+#ifndef _ANIM_H_
+#define _ANIM_H_
+
+// 고정 시간 간격 애니메이션 시계
+// 메인 루프 한 바퀴마다 anim_update() 가 지난 시간을 쌓아서 ANIM_HZ 간격 스텝이 몇 번 돌았는지 알려 줌
+// → 렌더/리프레시 시간이 바뀌어도 회전 속도(초당 각도)는 그대로, 시뮬레이션과 렌더 속도가 분리됨
+// 시간원: 보드는 SysTick (HAL 1ms tick + SysTick->VAL 로 1ms 안쪽까지),
+//         TIM3 은 OE 펄스(one-pulse)에 쓰고 있어서 시계로 못 씀, HOST_BUILD 는 clock_gettime
+// 실측 렌더 fps / 시뮬레이션 스텝 수는 1초마다 prof_stats.draw_fps / sim_hz 에 넣음
+
+#include <stdint.h>
+
+#ifndef ANIM_HZ
+#define ANIM_HZ 120 // 시뮬레이션 스텝 (초당), 렌더보다 빠르게 둬야 렌더마다 새 상태가 있음
+#endif
+#define ANIM_STEP_US (1000000u / ANIM_HZ)
+#define ANIM_DT (1.0f / ANIM_HZ)       // 스텝 하나 (초)
+#define ANIM_MAX_STEPS 8               // 한 번에 따라잡는 최대 스텝 (디버거로 멈췄다 풀렸을 때 폭주 방지)
+
+typedef struct
+{
+  uint32_t last_us;   // 마지막 anim_update() 시각
+  uint32_t acc_us;    // 아직 스텝으로 못 바꾼 시간
+  uint32_t window_us; // 통계 창 시작
+  uint32_t frames;    // 창 안에서 anim_frame() 횟수
+  uint32_t steps;     // 창 안에서 돈 스텝 수
+} anim_clock_t;
+
+uint32_t anim_now_us(void); // 단조 증가 (32비트, 약 71분마다 한 바퀴, 차이는 그대로 유효)
+
+void anim_init(anim_clock_t *c);
+uint8_t anim_update(anim_clock_t *c); // 이번에 돌릴 스텝 수 (0 ~ ANIM_MAX_STEPS)
+void anim_frame(anim_clock_t *c);     // 렌더한 프레임 하나 (fps 통계)
+
+#endif
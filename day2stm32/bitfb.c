@@ -0,0 +1,284 @@
+#include "bitfb.h"
+#include "hub75_map.h"
+#include <string.h>
+
+#define BF_W PANEL_WIDTH_TOTAL // plane 하나 = 컬럼 수만큼 칸
+
+static uint16_t slot_x[HUB75_IMG_W], slot_y[HUB75_IMG_H]; // hub75_map_slots()
+static uint8_t row_run;  // 1: 같은 y 에서 x 가 한 칸씩 이웃 컬럼 (rotate 0/2) → 스팬 = 연속 컬럼
+static hub75_px_t *bf;   // 대상 버퍼의 [0][0][0]
+static uint32_t last_rgb;
+static bitfb_color_t last_color;
+
+void bitfb_init(void)
+{
+  hub75_map_slots(slot_x, slot_y);
+
+  uint16_t d = (uint16_t)(slot_x[1] - slot_x[0]);
+  row_run = (d == 2 || d == (uint16_t)-2);
+  for (uint8_t x = 1; x + 1 < HUB75_IMG_W && row_run; x++)
+  {
+    row_run = (uint16_t)(slot_x[x + 1] - slot_x[x]) == d;
+  }
+
+  last_rgb = 0;
+  last_color = hub75_pal_entry(0, 0, 0);
+}
+
+void bitfb_target(hub75_row_t *buf) { bf = &buf[0][0][0]; }
+
+bitfb_color_t bitfb_color(uint8_t r, uint8_t g, uint8_t b) { return hub75_pal_entry(r, g, b); }
+
+bitfb_color_t bitfb_rgb(uint32_t rgb)
+{
+  rgb &= 0xFFFFFF;
+  if (rgb != last_rgb)
+  {
+    last_rgb = rgb;
+    last_color = hub75_pal_entry((uint8_t)(rgb >> 16), (uint8_t)(rgb >> 8), (uint8_t)rgb);
+  }
+  return last_color;
+}
+
+void bitfb_clear(void)
+{
+#if HUB75_BSRR_SCAN
+  for (uint32_t i = 0; i < SCAN_LINES * sizeof(hub75_row_t) / sizeof(hub75_px_t); i++)
+  {
+    bf[i] = hub75_px(0);
+  }
+#else
+  memset(bf, 0, SCAN_LINES * sizeof(hub75_row_t));
+#endif
+}
+
+// 칸 하나의 상단 또는 하단 3비트를 v 로 (v 는 이미 그 위치로 시프트된 값)
+static inline void set_bits(hub75_px_t *px, uint8_t keep, uint8_t v)
+{
+  *px = hub75_px((uint8_t)((*px & keep) | v));
+}
+
+// 하단이면 색 비트 3~5, 상단이면 0~2 만 남기고, 칸에서 그대로 둘 비트
+#define COLOR_MASK(half) ((half) ? 0x3838383838383838ull : 0x0707070707070707ull)
+#define KEEP_MASK(half) ((uint8_t)((half) ? 0x07 : 0x38))
+
+void bitfb_put_pixel(int x, int y, bitfb_color_t c)
+{
+  if (x < 0 || x >= HUB75_IMG_W || y < 0 || y >= HUB75_IMG_H) return;
+
+  uint16_t s = (uint16_t)(slot_x[x] + slot_y[y]);
+  hub75_px_t *px = bf + (s >> 1);
+  uint8_t keep = KEEP_MASK(s & 1);
+  c &= COLOR_MASK(s & 1);
+
+  for (uint8_t plane = 0; plane < SCAN_PLANES; plane++, px += BF_W)
+  {
+    set_bits(px, keep, (uint8_t)(c >> (8 * plane)));
+  }
+}
+
+// 연속 칸 lo ~ hi 의 plane 하나: 4컬럼씩 워드 읽기-수정-쓰기 (바이트 레인 = 컬럼)
+static inline void run_bits(hub75_px_t *row, uint16_t lo, uint16_t hi, uint8_t keep, uint8_t v)
+{
+  uint16_t c = lo;
+#if !HUB75_BSRR_SCAN
+  for (; c <= hi && (c & 3); c++) set_bits(&row[c], keep, v);
+
+  uint32_t keep4 = keep * 0x01010101u, v4 = v * 0x01010101u;
+  for (; c + 3 <= hi; c += 4)
+  {
+    uint32_t w;
+    memcpy(&w, &row[c], sizeof(w));
+    w = (w & keep4) | v4;
+    memcpy(&row[c], &w, sizeof(w));
+  }
+#endif
+  for (; c <= hi; c++) set_bits(&row[c], keep, v);
+}
+
+void bitfb_hline(int x0, int x1, int y, bitfb_color_t c)
+{
+  if (y < 0 || y >= HUB75_IMG_H) return;
+  if (x0 < 0) x0 = 0;
+  if (x1 >= HUB75_IMG_W) x1 = HUB75_IMG_W - 1;
+  if (x0 > x1) return;
+
+  if (!row_run)
+  {
+    // rotate 1/3: x 가 바뀌면 주소가 바뀌므로 픽셀마다
+    for (int x = x0; x <= x1; x++) bitfb_put_pixel(x, y, c);
+    return;
+  }
+
+  // 같은 y 라서 주소/상하단이 같고 컬럼만 연속 (mirror 면 x 가 클수록 컬럼이 작음)
+  uint16_t s0 = (uint16_t)(slot_x[x0] + slot_y[y]), s1 = (uint16_t)(slot_x[x1] + slot_y[y]);
+  uint16_t lo = ((s0 < s1) ? s0 : s1) >> 1, hi = ((s0 < s1) ? s1 : s0) >> 1;
+  uint8_t keep = KEEP_MASK(s0 & 1);
+  c &= COLOR_MASK(s0 & 1);
+
+  hub75_px_t *plane0 = bf;
+  for (uint8_t plane = 0; plane < SCAN_PLANES; plane++, plane0 += BF_W)
+  {
+    run_bits(plane0, lo, hi, keep, (uint8_t)(c >> (8 * plane)));
+  }
+}
+
+void bitfb_blit(int x, int y, int w, int h, const uint8_t *idx, const bitfb_color_t *pal)
+{
+  for (int j = 0; j < h; j++)
+  {
+    if (y + j < 0 || y + j >= HUB75_IMG_H) continue;
+    for (int i = 0; i < w; i++)
+    {
+      uint8_t k = idx[j * w + i];
+      if (k) bitfb_put_pixel(x + i, y + j, pal[k]);
+    }
+  }
+}
+
+#if defined(HOST_BUILD) && defined(BITFB_BENCH)
+// 호스트 벤치마크: 같은 스팬들을 RGB fb 에 채우고 hub75_pack_frame × 16 vs 스캔 버퍼에 바로 채우기
+//   gcc -O2 -DHOST_BUILD -DBITFB_BENCH bitfb.c hub75_map.c hub75_pack.c hub75.c hub75_rec.c prof.c -o bitfb && ./bitfb
+// 회전/반전/채널 순서를 바꿔 가며 스팬/점/스프라이트 결과가 패킹 결과와 바이트 단위로 같은지도 확인
+#include <stdio.h>
+#include <stdlib.h>
+#include "prof.h"
+
+#define BENCH_ROUNDS 2000
+#define BENCH_SPANS 256 // 프레임당 스팬 수 (큐브 한 장 ≈ 60, 토러스 ≈ 250)
+
+typedef struct
+{
+  uint8_t r[HUB75_IMG_W], g[HUB75_IMG_W], b[HUB75_IMG_W];
+} rgb_row_t;
+
+static rgb_row_t fb[HUB75_IMG_H];
+static hub75_row_t out_rgb[SCAN_LINES], out_bit[SCAN_LINES];
+
+typedef struct
+{
+  int16_t x0, x1, y;
+  uint8_t r, g, b;
+} span_t;
+static span_t spans[BENCH_SPANS];
+
+static void rgb_hline(int x0, int x1, int y, uint8_t r, uint8_t g, uint8_t b)
+{
+  if (x0 < 0) x0 = 0;
+  if (x1 >= HUB75_IMG_W) x1 = HUB75_IMG_W - 1;
+  if (x0 > x1 || y < 0 || y >= HUB75_IMG_H) return;
+  memset(&fb[y].r[x0], r, x1 - x0 + 1);
+  memset(&fb[y].g[x0], g, x1 - x0 + 1);
+  memset(&fb[y].b[x0], b, x1 - x0 + 1);
+}
+
+static void rgb_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) { rgb_hline(x, x, y, r, g, b); }
+
+static void pack_rgb(void)
+{
+  for (uint8_t a = 0; a < SCAN_LINES; a++) hub75_pack_frame(&out_rgb[a], a, (const uint8_t *)fb);
+}
+
+static void random_spans(void)
+{
+  for (int i = 0; i < BENCH_SPANS; i++)
+  {
+    int x0 = rand() % 72 - 4, len = rand() % 40;
+    spans[i] = (span_t){(int16_t)x0, (int16_t)(x0 + len), (int16_t)(rand() % 64),
+                        (uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand()};
+  }
+}
+
+int main(void)
+{
+  static const uint8_t sprite[7 * 8] = {
+      0, 0, 0, 1, 1, 0, 0, 0,
+      0, 0, 1, 2, 2, 1, 0, 0,
+      1, 1, 2, 3, 3, 2, 1, 1,
+      0, 1, 2, 3, 3, 2, 1, 0,
+      0, 0, 1, 2, 2, 1, 0, 0,
+      0, 1, 1, 0, 0, 1, 1, 0,
+      1, 1, 0, 0, 0, 0, 1, 1,
+  };
+  static const uint8_t sprite_rgb[4][3] = {{0, 0, 0}, {255, 0, 0}, {255, 200, 0}, {255, 255, 255}};
+  bitfb_color_t sprite_pal[4];
+  hub75_geom_t g;
+  int bad = 0;
+  srand(1);
+
+  for (int t = 0; t < HUB75_GEOM_SWEEP; t++)
+  {
+    hub75_geom_sweep(&g, t);
+    hub75_map_init(&g);
+    bitfb_init();
+    for (int i = 0; i < 4; i++) sprite_pal[i] = bitfb_color(sprite_rgb[i][0], sprite_rgb[i][1], sprite_rgb[i][2]);
+
+    memset(fb, 0, sizeof(fb));
+    bitfb_target(out_bit);
+    bitfb_clear();
+    random_spans();
+    for (int i = 0; i < BENCH_SPANS; i++)
+    {
+      const span_t *s = &spans[i];
+      if (i % 3)
+      {
+        rgb_hline(s->x0, s->x1, s->y, s->r, s->g, s->b);
+        bitfb_hline(s->x0, s->x1, s->y, bitfb_color(s->r, s->g, s->b));
+      }
+      else
+      {
+        rgb_pixel(s->x0, s->y, s->r, s->g, s->b);
+        bitfb_put_pixel(s->x0, s->y, bitfb_rgb(((uint32_t)s->r << 16) | (s->g << 8) | s->b));
+      }
+    }
+    for (int k = 0; k < 20; k++)
+    {
+      int sx = rand() % 72 - 8, sy = rand() % 72 - 8;
+      bitfb_blit(sx, sy, 8, 7, sprite, sprite_pal);
+      for (int j = 0; j < 7; j++)
+        for (int i = 0; i < 8; i++)
+        {
+          uint8_t c = sprite[j * 8 + i];
+          if (c && sx + i >= 0 && sx + i < 64 && sy + j >= 0 && sy + j < 64)
+            rgb_pixel(sx + i, sy + j, sprite_rgb[c][0], sprite_rgb[c][1], sprite_rgb[c][2]);
+        }
+    }
+    pack_rgb();
+    bad += memcmp(out_rgb, out_bit, sizeof(out_rgb)) != 0;
+  }
+
+  // 기본 배치: 색은 미리 bitfb_color 로 바꿔 둠 (면마다 한 번인 렌더러와 같게)
+  hub75_geom_default(&g);
+  hub75_map_init(&g);
+  bitfb_init();
+  random_spans();
+  static bitfb_color_t span_color[BENCH_SPANS];
+  for (int i = 0; i < BENCH_SPANS; i++) span_color[i] = bitfb_color(spans[i].r, spans[i].g, spans[i].b);
+
+  uint32_t t0 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (int i = 0; i < BENCH_SPANS; i++)
+      rgb_hline(spans[i].x0, spans[i].x1, spans[i].y, spans[i].r, spans[i].g, spans[i].b);
+  uint32_t t1 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++) pack_rgb();
+  uint32_t t2 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (int i = 0; i < BENCH_SPANS; i++) bitfb_hline(spans[i].x0, spans[i].x1, spans[i].y, span_color[i]);
+  uint32_t t3 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++) memset(fb, 0, sizeof(fb));
+  uint32_t t4 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++) bitfb_clear();
+  uint32_t t5 = prof_now();
+
+  // prof_now() 는 호스트에서 ns
+  double fill_rgb = (t1 - t0) / 1e3 / BENCH_ROUNDS, pack = (t2 - t1) / 1e3 / BENCH_ROUNDS;
+  double fill_bit = (t3 - t2) / 1e3 / BENCH_ROUNDS;
+  double clr_rgb = (t4 - t3) / 1e3 / BENCH_ROUNDS, clr_bit = (t5 - t4) / 1e3 / BENCH_ROUNDS;
+  printf("SCAN_PLANES %d, %d spans (1~40 px) per frame\n", SCAN_PLANES, BENCH_SPANS);
+  printf("                 clear     spans      pack     total (us)\n");
+  printf("  rgb fb      %8.2f  %8.2f  %8.2f  %8.2f\n", clr_rgb, fill_rgb, pack, clr_rgb + fill_rgb + pack);
+  printf("  bitplane    %8.2f  %8.2f  %8.2f  %8.2f\n", clr_bit, fill_bit, 0.0, clr_bit + fill_bit);
+  printf("  %d / %d layouts differ\n", bad, HUB75_GEOM_SWEEP);
+  return bad != 0;
+}
+#endif
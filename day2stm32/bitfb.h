@@ -0,0 +1,28 @@
+#ifndef _BITFB_H_
+#define _BITFB_H_
+
+// 비트플레인 fb: 스캔 버퍼 (hub75_row_t [주소][plane][컬럼], 컬럼 바이트 = PA0~PA5) 에 바로 그리기
+// 픽셀 하나 = plane 마다 그 컬럼 칸의 상단 (비트 0~2) 또는 하단 (비트 3~5) 3비트, 그리기가 그 비트만 바꾸므로
+// fb → plane 패킹 단계가 없고 스캔은 그린 버퍼를 그대로 내보냄
+// 대신 픽셀/스팬마다 plane 수만큼 읽기-수정-쓰기 (RGB fb 는 채널당 바이트 저장 한 번)
+// 그릴 버퍼는 bitfb_target() 으로 (보통 hub75_back(), 두 프레임 전 내용이라 바뀐 곳은 front 에서 복사한 뒤 그림)
+
+#include "hub75.h"
+
+// 색 = 감마/채널 순서를 거친 plane 비트 (hub75_pal_entry, 바이트 p = plane p)
+typedef uint64_t bitfb_color_t;
+
+void bitfb_init(void); // 픽셀 → 칸 표, hub75_map_init() 뒤에 (배치를 바꾸면 다시)
+void bitfb_target(hub75_row_t *buf);
+
+bitfb_color_t bitfb_color(uint8_t r, uint8_t g, uint8_t b);
+bitfb_color_t bitfb_rgb(uint32_t rgb); // 0xRRGGBB, 마지막 색을 기억해서 같은 색이면 표 계산 없이
+
+void bitfb_clear(void); // 대상 버퍼 전체를 검은색으로
+void bitfb_put_pixel(int x, int y, bitfb_color_t c);
+void bitfb_hline(int x0, int x1, int y, bitfb_color_t c); // x0 ~ x1 (양 끝 포함), 화면 밖은 자름
+
+// w × h 스프라이트 (색 번호 1바이트/픽셀, 행 우선) 를 (x, y) 에, 색 0 은 투명, pal[색 번호] = bitfb_color()
+void bitfb_blit(int x, int y, int w, int h, const uint8_t *idx, const bitfb_color_t *pal);
+
+#endif
@@ -0,0 +1,252 @@
+#include "blit.h"
+#include <string.h>
+
+// 작업 하나 = 사각형 하나 (선형 채우기/복사는 rows = 1)
+// src 가 NULL 이면 채우기: 소스 주소를 고정(PINC=0)하고 fill 워드를 계속 읽음
+typedef struct
+{
+  uint8_t *dst;
+  const uint8_t *src;
+  int32_t dst_stride, src_stride;
+  uint16_t width, rows;
+  uint32_t fill; // value 를 네 바이트에 복제 (DMA 가 읽는 곳이라 작업이 끝날 때까지 유지)
+  blit_cb_t cb;
+  void *arg;
+} blit_job_t;
+
+#ifndef HOST_BUILD
+#include "main.h"
+
+#define BLIT_STREAM DMA2_Stream0
+#define BLIT_IRQ DMA2_Stream0_IRQn
+#define BLIT_FLAGS (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0)
+
+static blit_job_t queue[BLIT_QUEUE];
+static volatile uint8_t q_head, q_count; // q_head: 진행 중인 작업
+static uint16_t row_left;                // 진행 중인 작업의 남은 줄 (지금 줄 포함)
+
+// 지금 작업의 줄 하나 시작 (정렬에 따라 바이트/워드/4워드 버스트)
+static void start_row(const blit_job_t *j, const uint8_t *dst, const uint8_t *src)
+{
+  uintptr_t align = (uintptr_t)dst | j->width;
+  if (src) align |= (uintptr_t)src;
+
+  uint32_t cr = DMA_SxCR_DIR_1 | DMA_SxCR_MINC | DMA_SxCR_TCIE | DMA_SxCR_TEIE; // 메모리 → 메모리, 우선순위 낮음
+  uint32_t n = j->width;
+  if (!(align & 3))
+  {
+    cr |= DMA_SxCR_PSIZE_1 | DMA_SxCR_MSIZE_1;
+    n /= 4;
+    // FIFO 가 4워드라 버스트 하나 = FIFO 한 번, 16바이트 정렬이면 1KB 경계도 넘지 않음
+    if (!(align & 15)) cr |= DMA_SxCR_PBURST_0 | DMA_SxCR_MBURST_0;
+  }
+  if (src) cr |= DMA_SxCR_PINC;
+
+  BLIT_STREAM->CR = 0;
+  DMA2->LIFCR = BLIT_FLAGS;
+  BLIT_STREAM->PAR = (uint32_t)(uintptr_t)(src ? src : (const uint8_t *)&j->fill);
+  BLIT_STREAM->M0AR = (uint32_t)(uintptr_t)dst;
+  BLIT_STREAM->NDTR = n;
+  BLIT_STREAM->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH; // 메모리-메모리는 FIFO 필수
+  BLIT_STREAM->CR = cr | DMA_SxCR_EN;
+}
+
+static void start_job(void)
+{
+  const blit_job_t *j = &queue[q_head];
+  row_left = j->rows;
+  start_row(j, j->dst, j->src);
+}
+
+void blit_init(void)
+{
+  RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+  (void)RCC->AHB1ENR;
+  BLIT_STREAM->CR = 0;
+  DMA2->LIFCR = BLIT_FLAGS;
+  q_head = 0;
+  q_count = 0;
+  NVIC_SetPriority(BLIT_IRQ, 2); // 스캔 인터럽트 (0) 보다 낮게
+  NVIC_EnableIRQ(BLIT_IRQ);
+}
+
+static void push(const blit_job_t *j)
+{
+  if (!j->width || !j->rows)
+  {
+    if (j->cb) j->cb(j->arg);
+    return;
+  }
+  while (q_count >= BLIT_QUEUE)
+    ;
+
+  __disable_irq();
+  queue[(q_head + q_count) % BLIT_QUEUE] = *j;
+  if (q_count++ == 0) start_job();
+  __enable_irq();
+}
+
+// 줄 하나 끝: 남은 줄이 있으면 다음 줄, 아니면 콜백 후 다음 작업
+void DMA2_Stream0_IRQHandler(void)
+{
+  DMA2->LIFCR = BLIT_FLAGS; // 전송 오류도 여기서 정리하고 다음으로 (이 줄은 덜 쓰였을 수 있음)
+
+  blit_job_t *j = &queue[q_head];
+  if (--row_left)
+  {
+    uint16_t done = j->rows - row_left;
+    start_row(j, j->dst + (int32_t)done * j->dst_stride, j->src ? j->src + (int32_t)done * j->src_stride : NULL);
+    return;
+  }
+
+  blit_cb_t cb = j->cb;
+  void *arg = j->arg;
+  q_head = (q_head + 1) % BLIT_QUEUE;
+  if (--q_count) start_job();
+  if (cb) cb(arg);
+}
+
+uint8_t blit_busy(void) { return q_count != 0; }
+
+void blit_wait(void)
+{
+  while (q_count)
+    ;
+}
+
+#else
+// 호스트: 그 자리에서 끝냄 (API/결과 확인용)
+
+static void push(const blit_job_t *j)
+{
+  uint8_t *d = j->dst;
+  const uint8_t *s = j->src;
+
+  for (uint16_t r = 0; r < j->rows; r++)
+  {
+    if (s)
+    {
+      memcpy(d, s, j->width);
+      s += j->src_stride;
+    }
+    else
+    {
+      memset(d, (uint8_t)j->fill, j->width);
+    }
+    d += j->dst_stride;
+  }
+  if (j->cb) j->cb(j->arg);
+}
+
+void blit_init(void) {}
+uint8_t blit_busy(void) { return 0; }
+void blit_wait(void) {}
+#endif
+
+// 선형 작업은 워드 정렬이 깨지지 않는 한 한 줄로, 너무 길면 같은 폭의 줄 여러 개 + 나머지 한 줄
+static void push_linear(uint8_t *dst, const uint8_t *src, uint8_t value, uint32_t len, blit_cb_t cb, void *arg)
+{
+  const uint32_t chunk = 0xFFF0; // 16바이트 배수, 바이트 단위여도 NDTR 에 들어감
+  uint32_t rows = len / chunk, rest = len % chunk;
+  blit_job_t j = {dst, src, chunk, chunk, (uint16_t)chunk, (uint16_t)rows, value * 0x01010101u, NULL, NULL};
+
+  if (rows)
+  {
+    if (!rest)
+    {
+      j.cb = cb;
+      j.arg = arg;
+    }
+    push(&j);
+  }
+  if (rest || !rows)
+  {
+    j.dst = dst + rows * chunk;
+    j.src = src ? src + rows * chunk : NULL;
+    j.width = (uint16_t)rest;
+    j.rows = 1;
+    j.cb = cb;
+    j.arg = arg;
+    push(&j);
+  }
+}
+
+void blit_fill(void *dst, uint8_t value, uint32_t len, blit_cb_t cb, void *arg)
+{
+  push_linear(dst, NULL, value, len, cb, arg);
+}
+
+void blit_copy(void *dst, const void *src, uint32_t len, blit_cb_t cb, void *arg)
+{
+  push_linear(dst, src, 0, len, cb, arg);
+}
+
+void blit_rect(void *dst, int32_t dst_stride, const void *src, int32_t src_stride,
+               uint16_t width, uint16_t rows, blit_cb_t cb, void *arg)
+{
+  blit_job_t j = {dst, src, dst_stride, src_stride, width, rows, 0, cb, arg};
+  push(&j);
+}
+
+void blit_fill_rect(void *dst, int32_t dst_stride, uint8_t value, uint16_t width, uint16_t rows,
+                    blit_cb_t cb, void *arg)
+{
+  blit_job_t j = {dst, NULL, dst_stride, 0, width, rows, value * 0x01010101u, cb, arg};
+  push(&j);
+}
+
+#if defined(HOST_BUILD) && defined(BLIT_MAIN)
+// 호스트 확인: 무작위 채우기/복사/사각형을 바이트 루프 결과와 비교, 콜백 횟수
+//   gcc -DHOST_BUILD -DBLIT_MAIN blit.c -o blit && ./blit
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint8_t src[8192], dst[8192], ref[8192];
+static int done;
+
+static void on_done(void *arg) { done += (int)(intptr_t)arg; }
+
+int main(void)
+{
+  int bad = 0;
+  srand(1);
+  blit_init();
+  for (int t = 0; t < 1000; t++)
+  {
+    for (int i = 0; i < 8192; i++)
+    {
+      src[i] = (uint8_t)rand();
+      dst[i] = ref[i] = (uint8_t)rand();
+    }
+    int off = rand() % 64, len = rand() % 4000, w = 1 + rand() % 100, rows = 1 + rand() % 20;
+    int ds = w + rand() % 50, ss = w + rand() % 50;
+    uint8_t v = (uint8_t)rand();
+
+    switch (t % 4)
+    {
+    case 0:
+      blit_fill(dst + off, v, len, on_done, (void *)1);
+      for (int i = 0; i < len; i++) ref[off + i] = v;
+      break;
+    case 1:
+      blit_copy(dst + off, src, len, on_done, (void *)1);
+      for (int i = 0; i < len; i++) ref[off + i] = src[i];
+      break;
+    case 2:
+      blit_rect(dst + off, ds, src, ss, w, rows, on_done, (void *)1);
+      for (int y = 0; y < rows; y++)
+        for (int x = 0; x < w; x++) ref[off + y * ds + x] = src[y * ss + x];
+      break;
+    default:
+      blit_fill_rect(dst + off, ds, v, w, rows, on_done, (void *)1);
+      for (int y = 0; y < rows; y++)
+        for (int x = 0; x < w; x++) ref[off + y * ds + x] = v;
+      break;
+    }
+    blit_wait();
+    bad += memcmp(dst, ref, sizeof(dst)) != 0;
+  }
+  printf("blit: %d mismatches, %d callbacks (expect 1000)\n", bad, done);
+  return bad || done != 1000;
+}
+#endif
@@ -0,0 +1,38 @@
+#ifndef _BLIT_H_
+#define _BLIT_H_
+
+// 메모리 → 메모리 블릿 (채우기, 복사, stride 가 있는 사각형 복사)
+// - 보드: DMA2 Stream0 메모리-메모리 전송 (F4 는 DMA2 만 가능), 요청은 큐에 넣고 바로 반환
+//         한 작업이 끝나면 인터럽트가 다음 작업(또는 사각형의 다음 줄)을 시작하고 콜백을 부름
+//         우선순위는 낮음이라 스캔 DMA (Stream1, 높음) 가 버스 중재에서 항상 이김
+// - HOST_BUILD: memset/memcpy 로 그 자리에서 끝내고 콜백도 바로 부름 (동기)
+// 전송이 끝나기 전에는 CPU 가 dst 를 만지면 안 됨 → blit_wait() 또는 콜백 뒤에 사용
+// 주소/길이가 4바이트 정렬이면 워드, 16바이트 정렬이면 4워드 버스트로 (아니면 바이트 단위라 느림)
+
+#include <stdint.h>
+
+#define BLIT_QUEUE 4 // 한 번에 걸어 둘 수 있는 작업 수 (꽉 차면 빌 때까지 기다림)
+
+// 작업 하나가 끝났을 때 (보드에서는 DMA 인터럽트 안에서 불림, 여기서 새 작업을 걸 때는 큐가 꽉 차지 않게)
+typedef void (*blit_cb_t)(void *arg);
+
+void blit_init(void); // DMA2 클럭, 인터럽트 설정
+
+// dst[0 .. len-1] = value
+void blit_fill(void *dst, uint8_t value, uint32_t len, blit_cb_t cb, void *arg);
+
+// dst[0 .. len-1] = src[0 .. len-1] (겹치면 안 됨)
+void blit_copy(void *dst, const void *src, uint32_t len, blit_cb_t cb, void *arg);
+
+// width 바이트 × rows 줄, 줄마다 dst += dst_stride, src += src_stride
+void blit_rect(void *dst, int32_t dst_stride, const void *src, int32_t src_stride,
+               uint16_t width, uint16_t rows, blit_cb_t cb, void *arg);
+
+// width 바이트 × rows 줄을 value 로, 줄마다 dst += dst_stride
+void blit_fill_rect(void *dst, int32_t dst_stride, uint8_t value, uint16_t width, uint16_t rows,
+                    blit_cb_t cb, void *arg);
+
+uint8_t blit_busy(void); // 1: 아직 끝나지 않은 작업이 있음
+void blit_wait(void);    // 걸어 둔 작업이 모두 끝날 때까지
+
+#endif
@@ -0,0 +1,164 @@
+#include "fbpal.h"
+#include "hub75_map.h"
+#include <string.h>
+
+uint8_t fbpal[HUB75_IMG_H][FBPAL_STRIDE] __attribute__((aligned(4)));
+
+static uint8_t pal_rgb[FBPAL_COLORS][3]; // LUT 를 다시 만들 때 쓰는 원래 색
+static uint64_t pal_lut[FBPAL_COLORS];   // hub75_pal_entry() (4비트 128바이트, 8비트 2KB)
+
+void fbpal_set_color(uint8_t i, uint8_t r, uint8_t g, uint8_t b)
+{
+  i &= FBPAL_COLORS - 1;
+  pal_rgb[i][0] = r;
+  pal_rgb[i][1] = g;
+  pal_rgb[i][2] = b;
+  pal_lut[i] = hub75_pal_entry(r, g, b);
+}
+
+void fbpal_set_palette(const uint8_t (*rgb)[3], uint16_t n)
+{
+  for (uint16_t i = 0; i < n && i < FBPAL_COLORS; i++)
+  {
+    fbpal_set_color((uint8_t)i, rgb[i][0], rgb[i][1], rgb[i][2]);
+  }
+}
+
+void fbpal_refresh(void)
+{
+  for (uint16_t i = 0; i < FBPAL_COLORS; i++)
+  {
+    pal_lut[i] = hub75_pal_entry(pal_rgb[i][0], pal_rgb[i][1], pal_rgb[i][2]);
+  }
+}
+
+void fbpal_init(void)
+{
+  for (uint16_t i = 0; i < FBPAL_COLORS; i++)
+  {
+    uint8_t v = (i < 8) ? 255 : (i < 16) ? 128 : 0;
+    fbpal_set_color((uint8_t)i, (i & 1) ? v : 0, (i & 2) ? v : 0, (i & 4) ? v : 0);
+  }
+  fbpal_clear(0);
+}
+
+void fbpal_clear(uint8_t c)
+{
+#if FBPAL_BPP == 8
+  memset(fbpal, c, sizeof(fbpal));
+#else
+  memset(fbpal, (c & 0x0F) * 0x11, sizeof(fbpal));
+#endif
+}
+
+void fbpal_hline(int x0, int x1, int y, uint8_t c)
+{
+  if (y < 0 || y >= HUB75_IMG_H) return;
+  if (x0 < 0) x0 = 0;
+  if (x1 >= HUB75_IMG_W) x1 = HUB75_IMG_W - 1;
+  if (x0 > x1) return;
+
+#if FBPAL_BPP == 8
+  memset(&fbpal[y][x0], c, x1 - x0 + 1);
+#else
+  // 양 끝 반 바이트만 따로, 가운데는 두 픽셀씩 memset
+  if (x0 & 1) fbpal_put_pixel(x0++, y, c);
+  if (!(x1 & 1)) fbpal_put_pixel(x1--, y, c);
+  if (x0 < x1) memset(&fbpal[y][x0 >> 1], (c & 0x0F) * 0x11, (x1 - x0 + 1) >> 1);
+#endif
+}
+
+void fbpal_pack(hub75_row_t *dst, uint8_t addr)
+{
+  hub75_pack_indexed(dst, addr, &fbpal[0][0], FBPAL_BPP, pal_lut);
+}
+
+#if defined(HOST_BUILD) && defined(FBPAL_BENCH)
+// 호스트 벤치마크: 같은 화면을 RGB fb (hub75_pack_frame, 워드 커널) vs 팔레트 fb (LUT) 로 16 주소 패킹
+//   gcc -O2 -DHOST_BUILD -DFBPAL_BENCH fbpal.c hub75_map.c hub75_pack.c hub75.c hub75_rec.c prof.c -o fbpal && ./fbpal
+// 회전/반전/채널 순서를 바꿔 가며 두 결과가 바이트 단위로 같은지도 확인
+#include <stdio.h>
+#include <stdlib.h>
+#include "prof.h"
+
+#define BENCH_ROUNDS 2000
+
+static uint8_t rgb[HUB75_IMG_H][3][HUB75_IMG_W]; // row_t 와 같은 배치
+static hub75_row_t out_rgb[SCAN_LINES], out_pal[SCAN_LINES];
+
+// 팔레트 fb 내용을 RGB fb 로 펼침
+static void expand(void)
+{
+  for (int y = 0; y < HUB75_IMG_H; y++)
+    for (int x = 0; x < HUB75_IMG_W; x++)
+      for (int ch = 0; ch < 3; ch++) rgb[y][ch][x] = pal_rgb[fbpal_get_pixel(x, y)][ch];
+}
+
+static void pack_both(void)
+{
+  for (uint8_t a = 0; a < SCAN_LINES; a++)
+  {
+    hub75_pack_frame(&out_rgb[a], a, &rgb[0][0][0]);
+    fbpal_pack(&out_pal[a], a);
+  }
+}
+
+int main(void)
+{
+  hub75_geom_t g;
+  int bad = 0;
+  srand(1);
+
+  // 배치마다 무작위 팔레트 + 무작위 가로줄/점으로 비교
+  for (int t = 0; t < HUB75_GEOM_SWEEP; t++)
+  {
+    hub75_geom_sweep(&g, t);
+    hub75_map_init(&g);
+    fbpal_init();
+    for (int i = 0; i < FBPAL_COLORS; i++) fbpal_set_color((uint8_t)i, rand(), rand(), rand());
+    for (int k = 0; k < 200; k++)
+    {
+      int x0 = rand() % 80 - 8, x1 = rand() % 80 - 8, y = rand() % 64;
+      if (k & 1) fbpal_hline(x0, x1, y, (uint8_t)rand());
+      else fbpal_put_pixel(x0, y, (uint8_t)rand());
+    }
+    expand();
+    pack_both();
+    bad += memcmp(out_rgb, out_pal, sizeof(out_rgb)) != 0;
+  }
+
+  // 기본 배치에서 시간
+  hub75_geom_default(&g);
+  hub75_map_init(&g);
+  fbpal_init();
+  for (int y = 0; y < HUB75_IMG_H; y++)
+    for (int x = 0; x < HUB75_IMG_W; x++) fbpal_put_pixel(x, y, (uint8_t)rand());
+  expand();
+
+  uint32_t t0 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (uint8_t a = 0; a < SCAN_LINES; a++) hub75_pack_frame(&out_rgb[a], a, &rgb[0][0][0]);
+  uint32_t t1 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (uint8_t a = 0; a < SCAN_LINES; a++) fbpal_pack(&out_pal[a], a);
+  uint32_t t2 = prof_now();
+  // 팔레트 교체: 색 전부 바꾸고 다시 패킹 (픽셀은 그대로)
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+  {
+    for (int i = 0; i < FBPAL_COLORS; i++) fbpal_set_color((uint8_t)i, (uint8_t)(i * 7 + k), (uint8_t)(i * 13), (uint8_t)k);
+    for (uint8_t a = 0; a < SCAN_LINES; a++) fbpal_pack(&out_pal[a], a);
+  }
+  uint32_t t3 = prof_now();
+
+  // prof_now() 는 호스트에서 ns
+  double pf = (t1 - t0) / 1e3 / BENCH_ROUNDS, pp = (t2 - t1) / 1e3 / BENCH_ROUNDS, sw = (t3 - t2) / 1e3 / BENCH_ROUNDS;
+  printf("FBPAL_BPP %d, SCAN_PLANES %d, 1 frame (%d addr x %d col)\n", FBPAL_BPP, SCAN_PLANES, SCAN_LINES,
+         PANEL_WIDTH_TOTAL);
+  printf("  rgb fb  %5u B, hub75_pack_frame : %8.2f us\n", (unsigned)sizeof(rgb), pf);
+  printf("  pal fb  %5u B, fbpal_pack       : %8.2f us  (x%.1f)\n", (unsigned)(sizeof(fbpal) + sizeof(pal_lut)), pp,
+         pf / pp);
+  printf("  palette swap (%d colors) + repack : %8.2f us\n", FBPAL_COLORS, sw);
+  printf("  %d / %d layouts differ\n", bad, HUB75_GEOM_SWEEP);
+  return bad != 0;
+}
+#endif
@@ -0,0 +1,59 @@
+#ifndef _FBPAL_H_
+#define _FBPAL_H_
+
+// 팔레트 (인덱스 색) 프레임 버퍼
+// 픽셀 = 색 번호 4비트 (16색, 2KB) 또는 8비트 (256색, 4KB), row_t fb (12KB) 대신 색 수가 적은 화면용
+// 패킹은 색 번호 → plane 비트 LUT (hub75_pal_entry) 한 번이라 픽셀마다 감마/비트 추출이 없고,
+// 팔레트만 바꾸고 다시 패킹하면 픽셀은 그대로 둔 채 화면 전체 색이 바뀜
+// 그리기는 3d.h 의 put_pixel() / fb_hline() 에 FB_INDEXED 를 골라서 쓰거나 아래 함수로 직접
+
+#include "hub75.h"
+
+#ifndef FBPAL_BPP
+#define FBPAL_BPP 4
+#endif
+#if FBPAL_BPP != 4 && FBPAL_BPP != 8
+#error "FBPAL_BPP must be 4 or 8"
+#endif
+#define FBPAL_COLORS (1 << FBPAL_BPP)
+#define FBPAL_STRIDE (HUB75_IMG_W * FBPAL_BPP / 8) // row 하나 바이트 수 (4비트면 짝수 x 가 하위 니블)
+
+extern uint8_t fbpal[HUB75_IMG_H][FBPAL_STRIDE];
+
+// 기본 팔레트 + 색 0 으로 지움, LUT 에 채널 순서가 들어가므로 hub75_map_init() 뒤에
+// 기본 팔레트: 0~7 = bit0 R, bit1 G, bit2 B 가 켜진 255 색 (0 검정, 7 흰색), 8~15 = 같은 색 128, 나머지 검정
+void fbpal_init(void);
+void fbpal_refresh(void); // 배치(hub75_map_init)를 바꾼 뒤 LUT 다시 만들기
+
+// 색 i 를 바꿈 (LUT 한 항목), 화면에는 다음 fbpal_pack() 부터
+void fbpal_set_color(uint8_t i, uint8_t r, uint8_t g, uint8_t b);
+void fbpal_set_palette(const uint8_t (*rgb)[3], uint16_t n); // 색 0 ~ n-1 한 번에
+
+void fbpal_clear(uint8_t c);
+void fbpal_hline(int x0, int x1, int y, uint8_t c); // x0 ~ x1 (양 끝 포함), 화면 밖은 자름
+
+static inline void fbpal_put_pixel(int x, int y, uint8_t c)
+{
+  if (x < 0 || x >= HUB75_IMG_W || y < 0 || y >= HUB75_IMG_H) return;
+#if FBPAL_BPP == 8
+  fbpal[y][x] = c;
+#else
+  uint8_t *p = &fbpal[y][x >> 1];
+  uint8_t sh = (x & 1) * 4;
+  *p = (uint8_t)((*p & ~(0x0F << sh)) | ((c & 0x0F) << sh));
+#endif
+}
+
+static inline uint8_t fbpal_get_pixel(int x, int y)
+{
+#if FBPAL_BPP == 8
+  return fbpal[y][x];
+#else
+  return (fbpal[y][x >> 1] >> ((x & 1) * 4)) & 0x0F;
+#endif
+}
+
+// 주소 addr 을 dst 에 BAM 패킹 (hub75_pack_frame 대신)
+void fbpal_pack(hub75_row_t *dst, uint8_t addr);
+
+#endif
@@ -0,0 +1,388 @@
+#include "hub75.h"
+#include "hub75_hw.h"
+#include "prof.h"
+#include <string.h>
+
+// 스캔 아웃 엔진
+//
+//  TIM1 (APB2 84MHz) : 픽셀 클럭 기준. OPM + RCR=127 → 128 주기 후 자동 정지
+//                      매 주기 CC1 이벤트마다 DMA2 Stream1(Ch6)이
+//                      scan_buf 1바이트를 GPIOA->ODR 하위 바이트(PA0~7)로 전송
+//                      (바이트 쓰기라 PA8~11 주소 핀은 건드리지 않음)
+//  TIM4 CH2 (PB7)    : TIM1 enable 에 gate 된 PWM → 주기 중간에 CLK 상승
+//  TIM3 CH2 (PB5=OE) : PWM mode 2 + one-pulse, active low
+//                      CCR2=1, ARR=표시시간 → 그 시간만큼 OE Low 후 하드웨어가 High 로 복귀
+//  TIM1 UPDATE IRQ   : 128컬럼 전송 끝
+//  TIM3 UPDATE IRQ   : OE 펄스 끝
+//                      둘 다 오면 주소 설정, LAT 펄스, OE 펄스 시작, 다음 plane 전송 시작
+//
+// OE 폭은 타이머가 만들기 때문에 인터럽트 지연/컴파일 옵션과 관계없이 밝기가 정확하고,
+// CPU는 인터럽트 두 개에서 레지스터 몇 개만 쓰고 나머지 시간은 렌더링에 사용
+//
+// HUB75_USE_DMA=0 이면 래치 + OE 펄스 시작 직후 CPU가 다음 plane 128컬럼을 직접 비트뱅잉
+// (OE 타이밍은 똑같이 TIM3 하드웨어)
+//
+// 어느 쪽이든 스캔은 scan_buf[front] 만 읽고, 메인 루프는 scan_buf[front ^ 1] 에 패킹한다.
+// 프레임 마지막 주소를 보낸 직후(vsync)에만 front 를 바꾸므로 화면이 찢어지지 않음
+
+hub75_row_t scan_buf[2][SCAN_LINES];
+
+static volatile uint8_t scan_front = 0;
+static volatile uint8_t swap_pending = 0;
+static volatile uint8_t scan_running = 0;
+static volatile uint32_t frame_count = 0;
+static uint32_t prof_frame_t, prof_hold_t; // 구간 시작 시각 (prof.h)
+static volatile int8_t frame_dither = -1; // 이번 프레임에 끼워 넣는 디더 plane (-1: 없음)
+
+#define TIM1_DMA_CHANNEL 6u
+#define DMA2_S1_CLEAR (DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1)
+
+uint32_t hub75_frame_count(void) { return frame_count; }
+
+hub75_row_t *hub75_back(void) { return scan_buf[scan_front ^ 1]; }
+
+void hub75_swap(void)
+{
+  if (!scan_running)
+  {
+    scan_front ^= 1;
+    return;
+  }
+  swap_pending = 1;
+  while (swap_pending)
+    ;
+}
+
+// 감마 2.2, round(255 * (i/255)^2.2)
+const uint8_t hub75_gamma[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+// 주소 하나 = plane 마다 max(128컬럼 전송, 가중치만큼 표시)  (시프트와 표시가 겹침)
+//   전송 DMA : 128 * HUB75_CLK_DIV         (84MHz tick)
+//   전송 CPU : 128 * HUB75_CPU_COL_TICKS   (컬럼당 사이클은 추정치)
+//   표시     : HUB75_HOLD_BASE * 2^p + 1
+uint32_t hub75_refresh_hz(uint8_t planes)
+{
+#if HUB75_USE_DMA
+  uint32_t shift = PANEL_WIDTH_TOTAL * HUB75_CLK_DIV;
+#else
+  uint32_t shift = PANEL_WIDTH_TOTAL * HUB75_CPU_COL_TICKS;
+#endif
+  uint32_t ticks = 0;
+  for (uint8_t p = 0; p < planes; p++)
+  {
+    uint32_t hold = (HUB75_HOLD_BASE << p) + 1;
+    ticks += (hold > shift) ? hold : shift;
+  }
+
+  // 디더 plane: 2^D 프레임 중 2^D - 1 프레임에 plane 0 과 같은 비용으로 하나씩
+  uint32_t hold0 = HUB75_HOLD_BASE + 1;
+  uint32_t extra = ((hold0 > shift) ? hold0 : shift) * ((1u << HUB75_DITHER_BITS) - 1);
+  ticks = (ticks << HUB75_DITHER_BITS) + extra;
+  return (84000000u << HUB75_DITHER_BITS) / (ticks * SCAN_LINES);
+}
+
+void hub75_clear(void)
+{
+#if HUB75_BSRR_SCAN
+  // 0 은 "아무 핀도 안 건드림" 이라 검은색 = reset 워드로 채움
+  hub75_px_t *px = &scan_buf[0][0][0][0];
+  for (uint32_t i = 0; i < sizeof(scan_buf) / sizeof(hub75_px_t); i++)
+  {
+    px[i] = hub75_px(0);
+  }
+#else
+  memset(scan_buf, 0, sizeof(scan_buf));
+#endif
+}
+
+// 스캔은 front 를 읽기만 하므로 스캔 중에 복사해도 안전
+void hub75_copy_front(uint32_t addr_mask)
+{
+  uint8_t front = scan_front;
+  for (uint8_t a = 0; a < SCAN_LINES; a++)
+  {
+    if (addr_mask & (1ul << a))
+    {
+      memcpy(scan_buf[front ^ 1][a], scan_buf[front][a], sizeof(hub75_row_t));
+    }
+  }
+}
+
+// 디더 순서: 2^D 프레임 주기에서 f = 0 은 없음, 나머지는 j = D-1-ctz(f)
+// → 비트 j plane 이 정확히 2^j 번 (D=2: -, 1, 0, 1), 큰 비트가 고르게 흩어져서 깜빡임이 적음
+static inline int8_t dither_plane(uint32_t frame)
+{
+#if HUB75_DITHER_BITS
+  uint32_t f = frame & ((1u << HUB75_DITHER_BITS) - 1);
+  if (!f) return -1;
+  return (int8_t)(HUB75_DITHER_BITS - 1 - __builtin_ctz(f));
+#else
+  (void)frame;
+  return -1;
+#endif
+}
+
+// 프레임 끝 (마지막 주소 전송 완료)
+static inline void vsync(void)
+{
+  uint32_t now = prof_now();
+  if (frame_count) prof_add(PROF_SCAN_FRAME, now - prof_frame_t);
+  prof_frame_t = now;
+
+  frame_count++;
+  frame_dither = dither_plane(frame_count);
+  if (swap_pending)
+  {
+    scan_front ^= 1;
+    swap_pending = 0;
+  }
+}
+
+void hub75_init(void)
+{
+  HW_WR(RCC->APB1ENR, HW_RD(RCC->APB1ENR) | RCC_APB1ENR_TIM3EN);
+
+  // TIM3 CH2 : OE one-pulse (CubeMX 설정 PSC=16 대신 84MHz tick 사용)
+  HW_WR(TIM3->CR1, TIM_CR1_URS | TIM_CR1_OPM);
+  HW_WR(TIM3->PSC, 0);
+  HW_WR(TIM3->ARR, HUB75_HOLD_BASE);
+  HW_WR(TIM3->CCR2, 1);
+  HW_WR(TIM3->CCMR1, 7u << TIM_CCMR1_OC2M_Pos); // PWM mode 2 : CNT >= CCR2 동안 active
+  HW_WR(TIM3->CCER, TIM_CCER_CC2E | TIM_CCER_CC2P); // active low = OE on
+  HW_WR(TIM3->EGR, TIM_EGR_UG);
+  HW_WR(TIM3->SR, 0);
+  HW_WR(TIM3->DIER, TIM_DIER_UIE);
+
+  // PB5 → AF2 (TIM3_CH2), 타이머 출력이 inactive(High) 로 잡힌 뒤에 전환
+  HW_WR(GPIOB->AFR[0], (HW_RD(GPIOB->AFR[0]) & ~(0xFu << 20)) | (2u << 20));
+  HW_WR(GPIOB->MODER, (HW_RD(GPIOB->MODER) & ~(3u << 10)) | (2u << 10));
+
+  NVIC_SetPriority(TIM3_IRQn, 0);
+  NVIC_EnableIRQ(TIM3_IRQn);
+
+#if SCAN_LINES > 16
+  // E 주소선 (PA12) : CubeMX GPIO 설정에는 A~D 만 있으므로 여기서 출력으로
+  HW_WR(GPIOA->MODER, (HW_RD(GPIOA->MODER) & ~(3u << 24)) | (1u << 24));
+#endif
+
+#if HUB75_USE_DMA
+  HW_WR(RCC->AHB1ENR, HW_RD(RCC->AHB1ENR) | RCC_AHB1ENR_DMA2EN);
+  HW_WR(RCC->APB2ENR, HW_RD(RCC->APB2ENR) | RCC_APB2ENR_TIM1EN);
+  HW_WR(RCC->APB1ENR, HW_RD(RCC->APB1ENR) | RCC_APB1ENR_TIM4EN);
+
+  // PA0~5 데이터 핀 속도 Very High (픽셀 클럭 5MHz 이상)
+  HW_WR(GPIOA->OSPEEDR, HW_RD(GPIOA->OSPEEDR) | 0x00000FFFu);
+  // PB7 → AF2 (TIM4_CH2), PB7/PB8 속도 Very High
+  HW_WR(GPIOB->MODER, (HW_RD(GPIOB->MODER) & ~(3u << 14)) | (2u << 14));
+  HW_WR(GPIOB->AFR[0], (HW_RD(GPIOB->AFR[0]) & ~(0xFu << 28)) | (2u << 28));
+  HW_WR(GPIOB->OSPEEDR, HW_RD(GPIOB->OSPEEDR) | (3u << 14) | (3u << 16));
+
+  // DMA2 Stream1 : memory(scan_buf) -> GPIOA->ODR[7:0], byte, TIM1_CH1 요청
+  HW_WR(DMA2_Stream1->CR, 0);
+  HW_WR(DMA2->LIFCR, DMA2_S1_CLEAR);
+  HW_WR(DMA2_Stream1->PAR, (uintptr_t)&GPIOA->ODR);
+  HW_WR(DMA2_Stream1->CR, (TIM1_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_1 |
+                              DMA_SxCR_MINC | DMA_SxCR_DIR_0);
+
+  // TIM1 : 픽셀 주기 HUB75_CLK_DIV, 128 주기 one-pulse, TRGO = enable
+  HW_WR(TIM1->CR1, TIM_CR1_URS | TIM_CR1_OPM);
+  HW_WR(TIM1->PSC, 0);
+  HW_WR(TIM1->ARR, HUB75_CLK_DIV - 1);
+  HW_WR(TIM1->RCR, PANEL_WIDTH_TOTAL - 1);
+  HW_WR(TIM1->CCR1, 1); // 주기 시작 직후 데이터 출력
+  HW_WR(TIM1->CR2, TIM_CR2_MMS_0);
+  HW_WR(TIM1->EGR, TIM_EGR_UG); // PSC/RCR 로드 (URS=1 이라 인터럽트 없음)
+  HW_WR(TIM1->SR, 0);
+  HW_WR(TIM1->DIER, TIM_DIER_UIE | TIM_DIER_CC1DE);
+
+  // TIM4 CH2 : PWM mode 2 → 주기 앞 절반 Low, 뒤 절반 High (데이터 안정 후 상승 에지)
+  HW_WR(TIM4->CR1, 0);
+  HW_WR(TIM4->PSC, 0);
+  HW_WR(TIM4->ARR, HUB75_CLK_DIV - 1);
+  HW_WR(TIM4->CCR2, HUB75_CLK_DIV / 2);
+  HW_WR(TIM4->CCMR1, 7u << TIM_CCMR1_OC2M_Pos);
+  HW_WR(TIM4->CCER, TIM_CCER_CC2E);
+  HW_WR(TIM4->SMCR, (0u << TIM_SMCR_TS_Pos) | TIM_SMCR_SMS_2 | TIM_SMCR_SMS_0); // ITR0(TIM1) gated
+  HW_WR(TIM4->CNT, 0);
+  HW_WR(TIM4->CR1, TIM_CR1_CEN);
+
+  NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 0);
+  NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+#endif
+}
+
+// 파이프라인:
+//   plane k 를 표시(OE 펄스)하는 동안 plane k+1 을 시프트 레지스터에 미리 밀어넣고,
+//   "시프트 끝" 과 "OE 펄스 끝" 두 이벤트가 모두 오면 k+1 을 래치해서 바로 표시.
+//   plane 하나의 시간이 (시프트 + 표시) 가 아니라 max(시프트, 표시) 가 된다.
+//   주소가 바뀌는 경계도 같은 방식 (래치 직전 OE 는 꺼져 있으므로 주소 변경 안전)
+
+static volatile uint8_t shift_addr = 0; // 지금 시프트 중인 주소
+static volatile uint8_t shift_step = 0; // 주소 안에서 몇 번째 표시인지 (디더 plane 포함)
+static volatile uint8_t shift_slot = 0; // 그 표시가 읽는 scan_buf plane
+static volatile uint16_t shift_hold = 0; // 그 표시의 OE 폭
+static volatile uint8_t pipe_wait = 0;   // 래치 전에 기다릴 이벤트 수
+
+// shift_step → 읽을 plane / OE 폭
+// 디더 plane 이 있는 프레임은 주소마다 맨 앞에 BAM plane 0 폭으로 한 번
+static inline void shift_select(void)
+{
+  uint8_t p = shift_step;
+  if (frame_dither >= 0)
+  {
+    if (p == 0)
+    {
+      shift_slot = (uint8_t)frame_dither;
+      shift_hold = HUB75_HOLD_BASE;
+      return;
+    }
+    p--;
+  }
+  shift_slot = HUB75_DITHER_BITS + p;
+  shift_hold = HUB75_HOLD_BASE << p;
+}
+
+// 시프트가 끝난 (shift_addr, shift_slot) 을 래치하고 OE 펄스 시작
+static inline void latch_and_show(void)
+{
+  uint32_t addr = shift_addr;
+  HW_WR(GPIOA->BSRR, (addr << ADDR_SHIFT) | (((~addr << ADDR_SHIFT) & ADDR_MASK) << 16));
+
+  // Latch Data
+  HW_WR(GPIOB->BSRR, PIN_LAT);
+  HW_WR(GPIOB->BSRR, (PIN_LAT << 16));
+
+  // OE Low 펄스, 폭 = plane 가중치
+  HW_WR(TIM3->ARR, shift_hold);
+  HW_WR(TIM3->CR1, TIM_CR1_URS | TIM_CR1_OPM | TIM_CR1_CEN);
+  prof_hold_t = prof_now();
+}
+
+// 다음에 시프트할 plane 으로 이동, 프레임이 넘어가면 vsync
+static inline void shift_advance(void)
+{
+  uint8_t steps = BAM_PLANES + (frame_dither >= 0);
+  if (++shift_step == steps)
+  {
+    shift_step = 0;
+    if (++shift_addr == SCAN_LINES)
+    {
+      shift_addr = 0;
+      vsync();
+    }
+  }
+  shift_select();
+}
+
+static void pipe_done(void);
+
+#if HUB75_USE_DMA
+static uint32_t prof_shift_t; // DMA 시프트 시작 시각 (CPU 스캔은 shift_begin 안에서 잼)
+
+// (shift_addr, shift_slot) 의 128바이트 DMA 전송 시작, 끝나면 TIM1 update IRQ
+static void shift_begin(void)
+{
+  HW_WR(DMA2_Stream1->CR, HW_RD(DMA2_Stream1->CR) & ~DMA_SxCR_EN);
+  HW_WR(DMA2->LIFCR, DMA2_S1_CLEAR);
+  HW_WR(DMA2_Stream1->M0AR, (uintptr_t)scan_buf[scan_front][shift_addr][shift_slot]);
+  HW_WR(DMA2_Stream1->NDTR, PANEL_WIDTH_TOTAL);
+  HW_WR(DMA2_Stream1->CR, HW_RD(DMA2_Stream1->CR) | DMA_SxCR_EN);
+
+  HW_WR(TIM4->CNT, 0);
+  HW_WR(TIM1->CR1, TIM_CR1_URS | TIM_CR1_OPM | TIM_CR1_CEN);
+  prof_shift_t = prof_now();
+}
+
+// 128컬럼 전송 완료
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+  uint32_t t = prof_now();
+  prof_add(PROF_SHIFT, t - prof_shift_t);
+
+  HW_WR(TIM1->SR, ~TIM_SR_UIF);
+  pipe_done();
+  prof_add(PROF_SCAN_IRQ, prof_now() - t);
+}
+#else
+// --- Render Logic (Direct Register Access, CPU 스캔) ---
+// OE 펄스는 하드웨어가 세고 있으므로, 그동안 CPU가 다음 plane 을 비트뱅잉
+static void shift_begin(void)
+{
+  const hub75_px_t *ptr = scan_buf[scan_front][shift_addr][shift_slot];
+  uint32_t t = prof_now();
+
+  for (uint16_t col = 0; col < PANEL_WIDTH_TOTAL; col++)
+  {
+    HW_WR(GPIOB->BSRR, (PIN_CLK << 16)); // CLK Low
+
+    // Set RGB Data (PA0~5)
+#if HUB75_BSRR_SCAN
+    HW_WR(GPIOA->BSRR, *ptr++); // set/reset 이 미리 인코딩되어 있어서 읽기/마스크 없음
+#else
+    HW_WR(GPIOA->ODR, (HW_RD(GPIOA->ODR) & ~RGB_MASK) | (*ptr++ & RGB_MASK));
+#endif
+
+    HW_WR(GPIOB->BSRR, PIN_CLK); // CLK High
+  }
+  prof_add(PROF_SHIFT, prof_now() - t);
+
+  pipe_done();
+}
+#endif
+
+// 시프트 끝 / OE 펄스 끝 이벤트. 둘 다 오면 래치 → 표시 시작 → 다음 plane 시프트
+// (TIM1, TIM3 인터럽트는 같은 우선순위라 서로 끼어들지 않음)
+static void pipe_done(void)
+{
+  if (--pipe_wait) return;
+  if (!scan_running) return;
+
+  pipe_wait = 2;
+  latch_and_show();
+  shift_advance();
+  shift_begin();
+}
+
+void hub75_start(void)
+{
+  shift_addr = 0;
+  shift_step = 0;
+  frame_dither = dither_plane(frame_count);
+  shift_select();
+  scan_running = 1;
+  pipe_wait = 1; // 첫 plane 은 표시 중인 것이 없으므로 시프트만 기다림
+  shift_begin();
+}
+
+void hub75_stop(void)
+{
+  scan_running = 0;
+}
+
+// OE 펄스 끝 (하드웨어가 이미 OE High 로 돌려놓음)
+void TIM3_IRQHandler(void)
+{
+  uint32_t t = prof_now();
+  prof_add(PROF_HOLD, t - prof_hold_t);
+
+  HW_WR(TIM3->SR, ~TIM_SR_UIF);
+  pipe_done();
+  prof_add(PROF_SCAN_IRQ, prof_now() - t);
+}
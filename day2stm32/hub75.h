@@ -0,0 +1,133 @@
+#ifndef _HUB75_H_
+#define _HUB75_H_
+
+#include <stdint.h>
+
+// --- PIN DEFINITIONS ---
+// RGB Data: PA0~PA5 (R1 G1 B1 R2 G2 B2)
+#define RGB_MASK 0x003F
+// Address: PA8~PA11 (A, B, C, D), 1/32 스캔이면 PA12 (E) 까지
+#define ADDR_MASK ((SCAN_LINES - 1) << ADDR_SHIFT)
+#define ADDR_SHIFT 8
+
+// Control Pins (Port B)
+#define PIN_OE GPIO_PIN_5  // TIM3_CH2 (AF2)
+#define PIN_CLK GPIO_PIN_7 // TIM4_CH2 (AF2)
+#define PIN_LAT GPIO_PIN_8
+
+// --- SETTINGS ---
+// 스캔 비율 1/HUB75_SCAN (8, 16, 32). 주소 하나가 패널의 상단 row 와 row + SCAN_LINES 를 동시에 구동
+#ifndef HUB75_SCAN
+#define HUB75_SCAN 16
+#endif
+#if HUB75_SCAN != 8 && HUB75_SCAN != 16 && HUB75_SCAN != 32
+#error "HUB75_SCAN must be 8, 16 or 32"
+#endif
+
+#define SCAN_LINES HUB75_SCAN
+#define PANEL_WIDTH 64                // 패널 한 개 가로
+#define PANEL_HEIGHT (2 * SCAN_LINES) // 패널 한 개 세로 (64x32 패널 = 1/16 스캔)
+
+// 논리 화면 (fb 와 같은 64x64) 을 패널 크기 타일로 나눠서 전부 한 체인에 연결
+#define HUB75_IMG_W 64
+#define HUB75_IMG_H 64
+#define HUB75_TILES_X (HUB75_IMG_W / PANEL_WIDTH)
+#define HUB75_TILES_Y (HUB75_IMG_H / PANEL_HEIGHT)
+#define HUB75_CHAIN (HUB75_TILES_X * HUB75_TILES_Y)  // 체인 패널 수
+#define PANEL_WIDTH_TOTAL (HUB75_CHAIN * PANEL_WIDTH) // 주소당 시프트 컬럼 수 (1/16: 64픽셀 패널 2개)
+
+// BAM 비트플레인 수 (1~8). plane p 는 가중치 2^p 만큼 표시
+// 깊이별 리프레시율은 hub75_refresh_hz() / README 표 참고
+#ifndef BAM_PLANES
+#define BAM_PLANES 6
+#endif
+#if BAM_PLANES < 1 || BAM_PLANES > 8
+#error "BAM_PLANES must be 1..8"
+#endif
+
+// 시간 디더링: BAM 아래 비트 HUB75_DITHER_BITS 개를 plane 으로 더 저장해 두고,
+// 2^D 프레임 동안 비트 j plane 을 2^j 번 (plane 0 표시 시간으로) 끼워 넣는다.
+// 평균 밝기는 BAM_PLANES + D 비트, 프레임당 추가 비용은 많아야 plane 1개
+#ifndef HUB75_DITHER_BITS
+#define HUB75_DITHER_BITS 0
+#endif
+#if BAM_PLANES + HUB75_DITHER_BITS > 8
+#error "BAM_PLANES + HUB75_DITHER_BITS must be <= 8"
+#endif
+#define SCAN_PLANES (HUB75_DITHER_BITS + BAM_PLANES) // 주소당 저장 plane (디더 plane 이 앞쪽)
+
+// 1: TIM1 + DMA2 가 픽셀을 밀어내고 타이머 인터럽트가 주소/래치/OE 진행 (CPU 거의 안 씀)
+// 0: OE 펄스가 끝날 때마다 TIM3 인터럽트에서 CPU가 다음 plane 을 비트뱅잉
+// 두 경우 모두 OE 폭은 TIM3 CH2 하드웨어 펄스, 메인 루프는 그리기만 한다
+#ifndef HUB75_USE_DMA
+#define HUB75_USE_DMA 1
+#endif
+
+// CPU 스캔 전용 스캔 버퍼 형식
+// 0: 컬럼당 1바이트 (PA0~PA5 값), 컬럼마다 ODR 읽기 → 마스크 → 쓰기
+// 1: 컬럼당 GPIOA->BSRR 에 그대로 쓸 32비트 (하위 = set, 상위 = reset), 컬럼마다 저장 한 번
+//    버퍼가 4배라서 SCAN_PLANES 가 작을 때만 RAM 에 들어감 (1/16 스캔 기준 2 plane 까지)
+#ifndef HUB75_BSRR_SCAN
+#define HUB75_BSRR_SCAN 0
+#endif
+#if HUB75_BSRR_SCAN && HUB75_USE_DMA
+#error "HUB75_BSRR_SCAN needs HUB75_USE_DMA=0 (DMA writes bytes to ODR)"
+#endif
+#if HUB75_BSRR_SCAN && (2 * SCAN_LINES * SCAN_PLANES * PANEL_WIDTH_TOTAL * 4) > 32768
+#error "HUB75_BSRR_SCAN scan buffer exceeds 32KB, reduce BAM_PLANES / HUB75_DITHER_BITS"
+#endif
+
+#define HUB75_CLK_DIV 16    // 픽셀 클럭 = 84MHz / 16 = 5.25MHz
+#define HUB75_HOLD_BASE 160    // plane 0 OE 펄스 폭 (TIM3 84MHz tick, 약 1.9us), plane p 는 << p
+// CPU 스캔 컬럼당 사이클 (리프레시율 추정용, Cortex-M4 명령 수 기준 추정치)
+//   ODR : ldrb + ldr ODR + bic/and/orr + str ODR + CLK str ×2 + 루프
+//   BSRR: ldr + str BSRR + CLK str ×2 + 루프
+#if HUB75_BSRR_SCAN
+#define HUB75_CPU_COL_TICKS 8
+#else
+#define HUB75_CPU_COL_TICKS 12
+#endif
+
+// 스캔 버퍼: [주소][plane][컬럼], 한 칸 = PA0~PA5 에 나가는 값 (hub75_px() 로 인코딩)
+// plane 0 ~ D-1 은 디더 비트, D ~ D+BAM_PLANES-1 이 BAM plane 0 ~ BAM_PLANES-1
+// front(스캔 중) / back(그리는 중) 두 장, vsync(주소 15 → 0)에서만 교체
+// 내용이 바뀐 프레임에서만 패킹하고, 스캔은 항상 이 버퍼에서만 읽는다
+#if HUB75_BSRR_SCAN
+typedef uint32_t hub75_px_t;
+#else
+typedef uint8_t hub75_px_t;
+#endif
+typedef hub75_px_t hub75_row_t[SCAN_PLANES][PANEL_WIDTH_TOTAL];
+
+// RGB 6비트 → 스캔 버퍼 한 칸 (BSRR 형식이면 꺼질 비트를 reset 쪽에)
+static inline hub75_px_t hub75_px(uint8_t rgb)
+{
+#if HUB75_BSRR_SCAN
+  return rgb | ((uint32_t)(~rgb & RGB_MASK) << 16);
+#else
+  return rgb;
+#endif
+}
+extern hub75_row_t scan_buf[2][SCAN_LINES];
+
+void hub75_init(void);
+void hub75_start(void); // 백그라운드 스캔 시작
+void hub75_stop(void);  // 현재 plane/주소 전송이 끝나면 멈춤
+uint32_t hub75_frame_count(void);
+
+hub75_row_t *hub75_back(void); // 다음 프레임을 패킹할 버퍼 (hub75_back()[addr][plane][col])
+void hub75_swap(void);         // back → front 교체 요청, 다음 vsync 까지 대기
+void hub75_clear(void);        // front/back 모두 검은 화면으로
+void hub75_copy_front(uint32_t addr_mask); // front 의 주소(bit a)들을 back 으로 복사 (이미 패킹된 row 재사용)
+
+// 8비트 채널값 → 감마(2.2) 보정 후 SCAN_PLANES 비트 밝기 단계
+extern const uint8_t hub75_gamma[256];
+static inline uint8_t hub75_level(uint8_t v)
+{
+  return hub75_gamma[v] >> (8 - SCAN_PLANES);
+}
+
+// plane 수별 이론 리프레시율 (Hz), 현재 클럭/홀드/디더 설정 기준 (디더 plane 은 평균)
+uint32_t hub75_refresh_hz(uint8_t planes);
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef _HUB75_HW_H_
+#define _HUB75_HW_H_
+
+// HUB75 드라이버용 레지스터 접근 계층
+// - 보드 빌드: main.h(CMSIS) 레지스터에 그대로 쓴다
+// - HOST_BUILD: 가짜 레지스터 블록에 쓰고, 모든 쓰기를 hub75_rec에 기록
+//   (보드 없이 PC에서 스캔 시퀀스를 확인하기 위함)
+
+#include <stdint.h>
+
+#ifndef HOST_BUILD
+
+#include "main.h"
+
+#define HW_WR(reg, val) ((reg) = (val))
+#define HW_RD(reg) (reg)
+
+#else /* HOST_BUILD */
+
+#define __IO volatile
+typedef uintptr_t hw_reg_t; // 호스트에서는 포인터가 들어갈 수 있게 레지스터 폭을 넓힘
+
+typedef struct
+{
+  __IO hw_reg_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+  __IO hw_reg_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR,
+      CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR;
+} TIM_TypeDef;
+
+typedef struct
+{
+  __IO hw_reg_t CR, NDTR, PAR, M0AR, M1AR, FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+  __IO hw_reg_t LISR, HISR, LIFCR, HIFCR;
+} DMA_TypeDef;
+
+typedef struct
+{
+  __IO hw_reg_t AHB1ENR, APB1ENR, APB2ENR;
+} RCC_TypeDef;
+
+extern GPIO_TypeDef host_gpioa, host_gpiob;
+extern TIM_TypeDef host_tim1, host_tim3, host_tim4;
+extern DMA_Stream_TypeDef host_dma2_stream1;
+extern DMA_TypeDef host_dma2;
+extern RCC_TypeDef host_rcc;
+
+#define GPIOA (&host_gpioa)
+#define GPIOB (&host_gpiob)
+#define TIM1 (&host_tim1)
+#define TIM3 (&host_tim3)
+#define TIM4 (&host_tim4)
+#define DMA2 (&host_dma2)
+#define DMA2_Stream1 (&host_dma2_stream1)
+#define RCC (&host_rcc)
+
+typedef enum
+{
+  TIM1_UP_TIM10_IRQn = 25,
+  TIM3_IRQn = 29,
+} IRQn_Type;
+
+#define NVIC_SetPriority(irq, prio) ((void)(irq), (void)(prio))
+#define NVIC_EnableIRQ(irq) ((void)(irq))
+#define NVIC_DisableIRQ(irq) ((void)(irq))
+#define __disable_irq() ((void)0)
+#define __enable_irq() ((void)0)
+
+// CMSIS(stm32f401xc.h)와 같은 이름/값으로 필요한 비트만
+#define GPIO_PIN_5 0x0020u
+#define GPIO_PIN_7 0x0080u
+#define GPIO_PIN_8 0x0100u
+
+#define TIM_CR1_CEN (1u << 0)
+#define TIM_CR1_URS (1u << 2)
+#define TIM_CR1_OPM (1u << 3)
+#define TIM_CR2_MMS_0 (1u << 4)
+#define TIM_SMCR_SMS_0 (1u << 0)
+#define TIM_SMCR_SMS_2 (1u << 2)
+#define TIM_SMCR_TS_Pos 4
+#define TIM_DIER_UIE (1u << 0)
+#define TIM_DIER_CC1DE (1u << 9)
+#define TIM_SR_UIF (1u << 0)
+#define TIM_EGR_UG (1u << 0)
+#define TIM_CCMR1_OC2M_Pos 12
+#define TIM_CCER_CC2E (1u << 4)
+#define TIM_CCER_CC2P (1u << 5)
+#define TIM_BDTR_MOE (1u << 15)
+
+#define DMA_SxCR_EN (1u << 0)
+#define DMA_SxCR_DIR_0 (1u << 6)
+#define DMA_SxCR_MINC (1u << 10)
+#define DMA_SxCR_PL_1 (1u << 17)
+#define DMA_SxCR_CHSEL_Pos 25
+#define DMA_LIFCR_CTCIF1 (1u << 11)
+#define DMA_LIFCR_CHTIF1 (1u << 10)
+#define DMA_LIFCR_CTEIF1 (1u << 9)
+#define DMA_LIFCR_CDMEIF1 (1u << 8)
+#define DMA_LIFCR_CFEIF1 (1u << 6)
+
+#define RCC_AHB1ENR_DMA2EN (1u << 22)
+#define RCC_APB2ENR_TIM1EN (1u << 0)
+#define RCC_APB1ENR_TIM3EN (1u << 1)
+#define RCC_APB1ENR_TIM4EN (1u << 2)
+
+#include "hub75_rec.h"
+
+#define HW_WR(reg, val) hub75_rec_write(&(reg), (hw_reg_t)(val), #reg)
+#define HW_RD(reg) (reg)
+
+#endif /* HOST_BUILD */
+
+#endif
@@ -0,0 +1,415 @@
+#include "hub75_map.h"
+#include "hub75_pack.h"
+#include <string.h>
+
+// 주소 addr, 출력 채널 k(R1 G1 B1 R2 G2 B2), 스캔 컬럼 c 가 읽는 fb 바이트:
+//   frame[map_off[k][c] + addr * map_step]
+// 주소가 하나 늘면 모든 컬럼이 패널 안에서 한 줄 내려가므로, 회전/반전을 거쳐도
+// 논리 좌표 변화량은 컬럼과 관계없이 같다 (row ±1 또는 컬럼 ±1)
+static uint16_t map_off[6][PANEL_WIDTH_TOTAL];
+static int16_t map_step;
+static uint32_t row_addrs[HUB75_IMG_H];
+static uint8_t col_x[PANEL_WIDTH_TOTAL]; // 스캔 컬럼 c 의 fb x (주소와 무관한 rotate 0/2 만)
+static uint8_t col_fixed;                // 0: rotate 1/3 이라 주소마다 x 가 바뀜
+
+// 인덱스 fb 패킹: 주소 0 에서 스캔 컬럼 c 의 상단/하단 픽셀 번호 (y × W + x), 주소가 하나 늘면 + pix_step
+static uint16_t pix_off[2][PANEL_WIDTH_TOTAL];
+static int16_t pix_step;
+static uint8_t map_ch[6]; // 출력 비트 k 에 내보낼 fb 채널
+
+#if HUB75_BANDS
+// 밴드 패킹: map_off 의 fb row 를 그 주소의 몇 번째 row 인지(j) 로 바꾼 표
+//   rows[band_off[k][c]] = fb 의 map_off[k][c] + addr * map_step 자리
+static uint16_t band_off[6][PANEL_WIDTH_TOTAL];
+static uint8_t band_y0[HUB75_BAND_ROWS]; // 주소 0 의 row (오름차순)
+static uint8_t band_n;                   // 0: rotate 1/3 이라 밴드 없음
+#endif
+
+void hub75_geom_default(hub75_geom_t *g)
+{
+  memset(g, 0, sizeof(*g));
+  for (uint8_t k = 0; k < HUB75_CHAIN; k++)
+  {
+    g->chain[k] = HUB75_CHAIN - 1 - k;
+  }
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    g->ch_top[i] = i;
+    g->ch_bot[i] = i;
+  }
+}
+
+#ifdef HOST_BUILD
+void hub75_geom_sweep(hub75_geom_t *g, int t)
+{
+  hub75_geom_default(g);
+  g->rotate = t & 3;
+  g->mirror_x = (t >> 2) & 1;
+  g->mirror_y = (t >> 3) & 1;
+  if (t & 16)
+  {
+    g->ch_top[0] = 2;
+    g->ch_top[2] = 0;
+  }
+  if (t & 32) g->ch_bot[1] = 0;
+}
+#endif
+
+// 패널 배치 좌표 (X, Y) 의 채널 ch → fb 바이트 오프셋
+static int32_t fb_offset(const hub75_geom_t *g, int X, int Y, uint8_t ch)
+{
+  int x, y;
+
+  if (g->mirror_x) X = HUB75_IMG_W - 1 - X;
+  if (g->mirror_y) Y = HUB75_IMG_H - 1 - Y;
+
+  switch (g->rotate & 3)
+  {
+  case 1:
+    x = HUB75_IMG_W - 1 - Y;
+    y = X;
+    break;
+  case 2:
+    x = HUB75_IMG_W - 1 - X;
+    y = HUB75_IMG_H - 1 - Y;
+    break;
+  case 3:
+    x = Y;
+    y = HUB75_IMG_H - 1 - X;
+    break;
+  default:
+    x = X;
+    y = Y;
+    break;
+  }
+  return (int32_t)y * HUB75_FB_STRIDE + ch * HUB75_IMG_W + x;
+}
+
+void hub75_map_init(const hub75_geom_t *g)
+{
+  memset(row_addrs, 0, sizeof(row_addrs));
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    map_ch[i] = g->ch_top[i] % 3;
+    map_ch[i + 3] = g->ch_bot[i] % 3;
+  }
+
+  for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+  {
+    uint8_t tile = g->chain[c / PANEL_WIDTH] % HUB75_CHAIN;
+    int X = (tile % HUB75_TILES_X) * PANEL_WIDTH + c % PANEL_WIDTH;
+    int Y = (tile / HUB75_TILES_X) * PANEL_HEIGHT;
+
+    for (uint8_t k = 0; k < 6; k++)
+    {
+      uint8_t half = k / 3; // 0: 상단 row, 1: 하단 row (+SCAN_LINES)
+      uint8_t ch = half ? g->ch_bot[k - 3] : g->ch_top[k];
+      map_off[k][c] = (uint16_t)fb_offset(g, X, Y + half * SCAN_LINES, ch % 3);
+
+      for (uint8_t a = 0; a < SCAN_LINES; a++)
+      {
+        int32_t off = fb_offset(g, X, Y + half * SCAN_LINES + a, 0);
+        row_addrs[off / HUB75_FB_STRIDE] |= 1ul << a;
+      }
+    }
+  }
+
+  map_step = (int16_t)(fb_offset(g, 0, 1, 0) - fb_offset(g, 0, 0, 0));
+
+  // fb 바이트 오프셋 y × STRIDE + ch × W + x → 픽셀 번호 y × W + x
+  for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+  {
+    for (uint8_t half = 0; half < 2; half++)
+    {
+      uint16_t off = map_off[half * 3][c];
+      pix_off[half][c] = (uint16_t)(off / HUB75_FB_STRIDE * HUB75_IMG_W + off % HUB75_IMG_W);
+    }
+  }
+  pix_step = (map_step == HUB75_FB_STRIDE) ? HUB75_IMG_W : (map_step == -HUB75_FB_STRIDE) ? -HUB75_IMG_W : map_step;
+
+  // 주소가 바뀌어도 row 만 바뀌면 컬럼 → fb x 가 고정 (상단/하단도 같은 x)
+  col_fixed = (map_step == HUB75_FB_STRIDE || map_step == -HUB75_FB_STRIDE);
+  for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+  {
+    col_x[c] = (uint8_t)(map_off[0][c] % HUB75_FB_STRIDE % HUB75_IMG_W);
+  }
+
+#if HUB75_BANDS
+  // 주소가 바뀌면 row 가 ±1 (rotate 0/2) 일 때만 주소 하나 = fb row 몇 개
+  band_n = 0;
+  if (map_step != HUB75_FB_STRIDE && map_step != -HUB75_FB_STRIDE) return;
+
+  uint64_t used = 0;
+  for (uint8_t k = 0; k < 6; k++)
+    for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+      used |= 1ull << (map_off[k][c] / HUB75_FB_STRIDE);
+
+  uint8_t slot[HUB75_IMG_H];
+  for (uint8_t y = 0; y < HUB75_IMG_H && band_n < HUB75_BAND_ROWS; y++)
+  {
+    if (!(used & (1ull << y))) continue;
+    slot[y] = band_n;
+    band_y0[band_n++] = y;
+  }
+  for (uint8_t k = 0; k < 6; k++)
+    for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+    {
+      uint16_t off = map_off[k][c];
+      band_off[k][c] = (uint16_t)(slot[off / HUB75_FB_STRIDE] * HUB75_FB_STRIDE + off % HUB75_FB_STRIDE);
+    }
+#endif
+}
+
+void hub75_pack_frame(hub75_row_t *dst, uint8_t addr, const uint8_t *frame)
+{
+  uint8_t ch[6][PANEL_WIDTH_TOTAL];
+  int32_t base = (int32_t)addr * map_step;
+
+  for (uint8_t k = 0; k < 6; k++)
+  {
+    const uint16_t *off = map_off[k];
+    for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+    {
+      ch[k][c] = frame[base + off[c]];
+    }
+  }
+
+  hub75_pack_span(dst, 0, PANEL_WIDTH_TOTAL, ch[0], ch[1], ch[2], ch[3], ch[4], ch[5]);
+}
+
+void hub75_pack_frame_dirty(hub75_row_t *buf, uint32_t addr_mask, const uint8_t *frame, uint8_t x0, uint8_t x1)
+{
+  // 패널마다 fb x0 ~ x1 이 보이는 스캔 컬럼 범위 (rotate 0/2 면 패널 안에서 연속), 4컬럼 단위로 넓힘
+  uint16_t lo[HUB75_CHAIN], hi[HUB75_CHAIN];
+  for (uint8_t p = 0; p < HUB75_CHAIN; p++)
+  {
+    lo[p] = p * PANEL_WIDTH;
+    hi[p] = lo[p] + PANEL_WIDTH - 1;
+    if (!col_fixed) continue;
+
+    uint16_t a = hi[p] + 1, b = 0;
+    for (uint16_t c = p * PANEL_WIDTH; c < (p + 1) * PANEL_WIDTH; c++)
+    {
+      if (col_x[c] < x0 || col_x[c] > x1) continue;
+      if (c < a) a = c;
+      b = c;
+    }
+    lo[p] = a & ~3u;
+    hi[p] = b | 3u;
+  }
+
+  uint8_t ch[6][PANEL_WIDTH_TOTAL];
+  for (uint8_t addr = 0; addr < SCAN_LINES; addr++)
+  {
+    if (!(addr_mask & (1ul << addr))) continue;
+    int32_t base = (int32_t)addr * map_step;
+
+    for (uint8_t p = 0; p < HUB75_CHAIN; p++)
+    {
+      if (lo[p] > hi[p]) continue;
+      for (uint8_t k = 0; k < 6; k++)
+      {
+        const uint16_t *off = map_off[k];
+        for (uint16_t c = lo[p]; c <= hi[p]; c++)
+        {
+          ch[k][c] = frame[base + off[c]];
+        }
+      }
+      uint16_t c = lo[p];
+      hub75_pack_span(&buf[addr], c, hi[p] - c + 1, &ch[0][c], &ch[1][c], &ch[2][c], &ch[3][c], &ch[4][c], &ch[5][c]);
+    }
+  }
+}
+
+uint64_t hub75_pal_entry(uint8_t r, uint8_t g, uint8_t b)
+{
+  const uint8_t lv[3] = {hub75_level(r), hub75_level(g), hub75_level(b)};
+  uint64_t e = 0;
+
+  for (uint8_t plane = 0; plane < SCAN_PLANES; plane++)
+  {
+    uint8_t bits = 0;
+    for (uint8_t k = 0; k < 6; k++)
+    {
+      bits |= ((lv[map_ch[k]] >> plane) & 1) << k;
+    }
+    e |= (uint64_t)bits << (8 * plane);
+  }
+  return e;
+}
+
+#define PAL_TOP 0x0707070707070707ull // 바이트마다 비트 0~2
+#define PAL_BOT 0x3838383838383838ull // 바이트마다 비트 3~5
+
+// bpp 를 상수로 펼쳐서 (inline) 니블/바이트 분기가 컬럼 루프 밖으로
+static inline void pack_indexed(hub75_row_t *dst, uint8_t addr, const uint8_t *frame, uint8_t bpp, const uint64_t *lut)
+{
+  int32_t base = (int32_t)addr * pix_step;
+
+  for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+  {
+    uint16_t pt = (uint16_t)(base + pix_off[0][c]), pb = (uint16_t)(base + pix_off[1][c]);
+    uint8_t it, ib;
+    if (bpp == 8)
+    {
+      it = frame[pt];
+      ib = frame[pb];
+    }
+    else
+    {
+      it = (frame[pt >> 1] >> ((pt & 1) * 4)) & 0x0F;
+      ib = (frame[pb >> 1] >> ((pb & 1) * 4)) & 0x0F;
+    }
+
+    // 픽셀 둘 = LUT 두 번, 비트 검사 없이 plane 마다 바이트 하나씩
+    uint64_t w = (lut[it] & PAL_TOP) | (lut[ib] & PAL_BOT);
+    for (uint8_t plane = 0; plane < SCAN_PLANES; plane++)
+    {
+      (*dst)[plane][c] = hub75_px((uint8_t)(w >> (8 * plane)));
+    }
+  }
+}
+
+void hub75_pack_indexed(hub75_row_t *dst, uint8_t addr, const uint8_t *frame, uint8_t bpp, const uint64_t *lut)
+{
+  if (bpp == 8) pack_indexed(dst, addr, frame, 8, lut);
+  else pack_indexed(dst, addr, frame, 4, lut);
+}
+
+void hub75_map_slots(uint16_t *x_part, uint16_t *y_part)
+{
+  // 스캔 칸마다 그 픽셀을 찾아서 x = 0 열, y = 0 행의 칸만 기록
+  for (uint8_t a = 0; a < SCAN_LINES; a++)
+    for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+      for (uint8_t half = 0; half < 2; half++)
+      {
+        uint16_t pi = (uint16_t)(pix_off[half][c] + (int32_t)a * pix_step);
+        uint16_t slot = (uint16_t)((((uint32_t)a * SCAN_PLANES * PANEL_WIDTH_TOTAL + c) << 1) | half);
+        if (pi / HUB75_IMG_W == 0) x_part[pi % HUB75_IMG_W] = slot;
+        if (pi % HUB75_IMG_W == 0) y_part[pi / HUB75_IMG_W] = slot;
+      }
+
+  // slot(x, y) = slot(x, 0) - slot(0, 0) + slot(0, y)
+  uint16_t base = y_part[0];
+  for (uint8_t x = 0; x < HUB75_IMG_W; x++)
+  {
+    x_part[x] -= base;
+  }
+}
+
+uint32_t hub75_map_row_addrs(uint8_t y) { return row_addrs[y]; }
+
+#if HUB75_BANDS
+uint8_t hub75_band_rows(uint8_t addr, uint8_t *ys)
+{
+  int8_t dy = (map_step > 0) ? 1 : -1;
+  for (uint8_t j = 0; j < band_n; j++)
+  {
+    ys[j] = (uint8_t)(band_y0[j] + addr * dy);
+  }
+  return band_n;
+}
+
+void hub75_pack_band(hub75_row_t *dst, const uint8_t *rows)
+{
+  uint8_t ch[6][PANEL_WIDTH_TOTAL];
+
+  for (uint8_t k = 0; k < 6; k++)
+  {
+    const uint16_t *off = band_off[k];
+    for (uint16_t c = 0; c < PANEL_WIDTH_TOTAL; c++)
+    {
+      ch[k][c] = rows[off[c]];
+    }
+  }
+
+  hub75_pack_span(dst, 0, PANEL_WIDTH_TOTAL, ch[0], ch[1], ch[2], ch[3], ch[4], ch[5]);
+}
+#endif
+
+#if defined(HOST_BUILD) && defined(HUB75_MAP_BENCH)
+// 호스트 확인: 큐브 모드 더티 패킹 (main.c CUBE_DIRTY_RECT 경로) vs 매 프레임 hub75_pack_frame × 16
+//   gcc -O2 -DHOST_BUILD -DHUB75_MAP_BENCH hub75_map.c 3d.c xform.c hub75_pack.c hub75.c hub75_rec.c prof.c -lm -o hub75_map && ./hub75_map
+// 배치마다 스캔 버퍼 두 개를 번갈아 back 으로 쓰면서 back 이 전체 패킹과 바이트 단위로 같은지 확인,
+// 중간에 레이어 모드에서 돌아온 것처럼 fb/스캔 버퍼를 더럽히고 전체 지우기 (main.c cubefull)
+#include "3d.h"
+#include "prof.h"
+#include <stdio.h>
+
+#define BENCH_FRAMES 300
+
+static hub75_row_t buf[2][SCAN_LINES], ref[SCAN_LINES];
+
+// main.c 큐브 루프의 한 프레임, back 버퍼에 더티 패킹하고 걸린 시간 (ns)
+static uint32_t cube_frame(int f, uint8_t full, hub75_row_t *back, fb_rect_t *back_rect)
+{
+  if (full) clear_framebuffer();
+  else clear_framebuffer_dirty();
+  render_cube_frame(0.015f * f, 0.021f * f);
+
+  uint32_t t0 = prof_now();
+  fb_rect_t dirty = render_dirty_rect();
+  fb_rect_t pack = fb_rect_union(dirty, *back_rect);
+  *back_rect = dirty;
+  uint32_t addr_mask = 0;
+  for (int y = pack.y0; y <= pack.y1 && pack.x0 <= pack.x1; y++)
+  {
+    addr_mask |= hub75_map_row_addrs((uint8_t)y);
+  }
+  hub75_pack_frame_dirty(back, addr_mask, (const uint8_t *)fb, (uint8_t)pack.x0, (uint8_t)pack.x1);
+  return prof_now() - t0;
+}
+
+static uint32_t pack_full(void)
+{
+  uint32_t t0 = prof_now();
+  for (uint8_t a = 0; a < SCAN_LINES; a++) hub75_pack_frame(&ref[a], a, (const uint8_t *)fb);
+  return prof_now() - t0;
+}
+
+int main(void)
+{
+  hub75_geom_t g;
+  int bad = 0;
+  double t_full = 0, t_dirty = 0;
+
+  for (int t = 0; t < HUB75_GEOM_SWEEP; t++)
+  {
+    hub75_geom_sweep(&g, t);
+    hub75_map_init(&g);
+    memset(buf, 0x3f, sizeof(buf));
+    fb_rect_t back_rect = {0, 0, -1, -1};
+    uint8_t back = 0, full = 1;
+
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+      if (f == BENCH_FRAMES / 2)
+      {
+        // 레이어 모드에서 돌아옴: fb 와 front 에 큐브 아닌 것, 두 프레임 동안 전체
+        memset(fb, 7, sizeof(fb));
+        memset(buf[back ^ 1], 0x15, sizeof(buf[0]));
+        back_rect = (fb_rect_t){0, 0, -1, -1};
+        full = 1;
+      }
+      uint32_t td = cube_frame(f, full, buf[back], &back_rect);
+      uint32_t tf = pack_full();
+      bad += memcmp(ref, buf[back], sizeof(ref)) != 0;
+      if (t == 0)
+      {
+        t_dirty += td;
+        t_full += tf;
+      }
+      back ^= 1;
+      full = 0;
+    }
+  }
+
+  // prof_now() 는 호스트에서 ns
+  printf("cube dirty repack, %d layouts x %d frames\n", HUB75_GEOM_SWEEP, BENCH_FRAMES);
+  printf("  hub75_pack_frame x %d    : %8.2f us\n", SCAN_LINES, t_full / 1e3 / BENCH_FRAMES);
+  printf("  hub75_pack_frame_dirty   : %8.2f us  (x%.2f, default layout)\n", t_dirty / 1e3 / BENCH_FRAMES,
+         t_full / t_dirty);
+  printf("  %d / %d frames differ\n", bad, HUB75_GEOM_SWEEP * BENCH_FRAMES);
+  return bad != 0;
+}
+#endif
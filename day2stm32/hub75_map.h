@@ -0,0 +1,84 @@
+#ifndef _HUB75_MAP_H_
+#define _HUB75_MAP_H_
+
+// 논리 화면(fb) 좌표 → 스캔 버퍼 위치 매핑
+// 패널 배치(체인 순서), 회전, 미러, 채널 순서를 hub75_geom_t 에 적어서 hub75_map_init() 에 넘기면
+// 컬럼별 오프셋 표로 바꿔 두고, 패킹은 모두 그 표만 읽는다 (픽셀마다 분기 없음)
+
+#include "hub75.h"
+
+// fb 메모리 배치: row 마다 r[W], g[W], b[W] (row_t 와 같음)
+#define HUB75_FB_STRIDE (3 * HUB75_IMG_W)
+
+typedef struct
+{
+  // 스캔 컬럼 k*PANEL_WIDTH ~ k*PANEL_WIDTH+63 이 표시되는 타일 번호
+  // 타일 = 패널 크기 칸, 가로 HUB75_TILES_X 개씩 위에서부터 행 우선 번호
+  uint8_t chain[HUB75_CHAIN];
+  uint8_t mirror_x; // 패널 배치 기준 좌우 반전
+  uint8_t mirror_y; // 패널 배치 기준 상하 반전
+  uint8_t rotate;   // 반전 후 시계 방향 90도 × rotate (0~3), 정사각 화면 기준
+  uint8_t ch_top[3]; // R1/G1/B1 에 내보낼 fb 채널 (0=r, 1=g, 2=b)
+  uint8_t ch_bot[3]; // R2/G2/B2
+} hub75_geom_t;
+
+// 기본 배치: 스캔 컬럼 앞쪽 패널이 화면 아래쪽, 회전/반전 없음, 채널 그대로
+void hub75_geom_default(hub75_geom_t *g);
+
+#ifdef HOST_BUILD
+// 호스트 벤치/검사용: 배치 번호 t (0 ~ HUB75_GEOM_SWEEP-1) 마다 회전, 반전, 채널 순서를 바꾼 배치
+// (비트 0~1 회전, 2 좌우, 3 상하, 4 상단 R/B 교환, 5 하단 G 를 R 로)
+#define HUB75_GEOM_SWEEP 64
+void hub75_geom_sweep(hub75_geom_t *g, int t);
+#endif
+
+// 오프셋 표 생성 (hub75_pack_frame 전에 한 번, 배치를 바꿀 때마다)
+void hub75_map_init(const hub75_geom_t *g);
+
+// 주소 addr 의 상단/하단 6채널을 frame(fb) 에서 표대로 모아서 dst 에 BAM 패킹
+void hub75_pack_frame(hub75_row_t *dst, uint8_t addr, const uint8_t *frame);
+
+// 더티 영역만 다시 패킹: addr_mask 의 주소마다 fb 컬럼 x0 ~ x1 이 보이는 스캔 컬럼만 buf[addr] 에
+// (4컬럼 단위로 넓힘, 나머지 컬럼은 buf 그대로). rotate 1/3 이면 컬럼은 전부
+void hub75_pack_frame_dirty(hub75_row_t *buf, uint32_t addr_mask, const uint8_t *frame, uint8_t x0, uint8_t x1);
+
+// 팔레트(인덱스) fb 패킹 (fbpal.h): 픽셀 = 색 번호, 번호 → plane 비트는 LUT 한 번
+// 색 하나의 LUT 값: 바이트 p = plane p 의 비트, 비트 0~2 는 상단 (R1 G1 B1), 3~5 는 하단 (R2 G2 B2) 으로 냈을 때
+// 감마와 채널 순서 (ch_top/ch_bot) 가 들어가므로 hub75_map_init() 뒤에 만들고, 배치를 바꾸면 다시
+uint64_t hub75_pal_entry(uint8_t r, uint8_t g, uint8_t b);
+
+// 주소 addr 을 인덱스 fb 에서 dst 에 BAM 패킹 (hub75_pack_frame 의 팔레트판)
+// frame: row 마다 HUB75_IMG_W × bpp / 8 바이트, bpp 4 면 짝수 x 가 하위 니블, lut[색 번호] = hub75_pal_entry()
+void hub75_pack_indexed(hub75_row_t *dst, uint8_t addr, const uint8_t *frame, uint8_t bpp, const uint64_t *lut);
+
+// 비트플레인 fb (bitfb.h): 픽셀 (x, y) 의 스캔 버퍼 칸 = x_part[x] + y_part[y] (uint16 덧셈)
+//   칸 >> 1 = &buf[0][0][0] 부터 그 픽셀의 plane 0 칸까지 (hub75_px_t 단위), 칸 & 1 = 하단 (R2 G2 B2)
+// 회전/반전을 거쳐도 x, y 중 하나는 패널 컬럼만, 다른 하나는 (타일, 주소, 상/하단) 만 정하므로 두 표의 합
+void hub75_map_slots(uint16_t *x_part, uint16_t *y_part);
+
+// 논리 row y 가 쓰이는 주소들의 비트마스크 (bit a = 주소 a)
+uint32_t hub75_map_row_addrs(uint8_t y);
+
+// 밴드 패킹 (3d.h RENDER_BANDS): fb 대신 주소 하나가 쓰는 row 들만 받아서 패킹
+// 밴드 오프셋 표가 1.5KB 라서 -DRENDER_BANDS=1 빌드에서만 (또는 HUB75_BANDS=1)
+#ifndef HUB75_BANDS
+#ifdef RENDER_BANDS
+#define HUB75_BANDS RENDER_BANDS
+#else
+#define HUB75_BANDS 0
+#endif
+#endif
+
+#define HUB75_BAND_ROWS (HUB75_IMG_H / SCAN_LINES) // 주소 하나가 쓰는 fb row 수
+
+#if HUB75_BANDS
+// 주소 addr 이 쓰는 fb row 번호를 ys[0 .. HUB75_BAND_ROWS-1] 에 (hub75_pack_band 의 rows 순서)
+// 한 주소가 fb row 가 아니라 컬럼에 걸치는 배치 (rotate 1/3) 면 0 반환
+uint8_t hub75_band_rows(uint8_t addr, uint8_t *ys);
+
+// rows[j] = fb row ys[j] (row_t 와 같은 r[W] g[W] b[W] 배치) 를 주소 하나로 dst 에 BAM 패킹
+// hub75_pack_frame(dst, addr, fb) 와 같은 결과
+void hub75_pack_band(hub75_row_t *dst, const uint8_t *rows);
+#endif
+
+#endif
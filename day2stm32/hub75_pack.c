@@ -0,0 +1,179 @@
+#include "hub75_pack.h"
+#include <string.h>
+
+// 비트 슬라이싱
+//   채널 하나의 4픽셀 밝기 단계를 32비트 워드 하나에 담으면 (바이트 레인 k = 픽셀 k)
+//   (w >> p) & 0x01010101 이 4픽셀의 plane p 비트를 각 레인의 bit0 에 모아준다.
+//   레인끼리 새는 비트는 위 레인의 하위 비트뿐이라 p < 8 이면 마스크에 걸리지 않음.
+//   여섯 채널을 << 0..5 로 OR 하면 그대로 스캔 버퍼 4바이트 (PA0~PA5 순서)
+//
+// Cortex-M4 에서는 AND/ORR 에 시프트가 붙어서 한 채널 = 명령 두 개,
+// 4픽셀 × 1 plane 이 비트 검사 24번 대신 명령 11개 + 워드 저장 1번
+// 워드 ↔ 바이트 순서는 리틀 엔디언 기준 (STM32, x86 호스트 모두 해당)
+
+#define LANE_LSB 0x01010101u
+#define LANE_LEVEL (LANE_LSB * ((1u << SCAN_PLANES) - 1))
+
+// hub75_level() 4픽셀분: 감마 LUT 4번 + 워드 단위 시프트 한 번
+static inline uint32_t level4(const uint8_t *p)
+{
+  uint32_t w = (uint32_t)hub75_gamma[p[0]] |
+               ((uint32_t)hub75_gamma[p[1]] << 8) |
+               ((uint32_t)hub75_gamma[p[2]] << 16) |
+               ((uint32_t)hub75_gamma[p[3]] << 24);
+  return (w >> (8 - SCAN_PLANES)) & LANE_LEVEL;
+}
+
+// 4픽셀 plane 워드 → 스캔 버퍼 4칸
+static inline void store4(hub75_px_t *out, uint32_t w)
+{
+#if HUB75_BSRR_SCAN
+  // 바이트 레인 k 를 BSRR 워드 k 로 펼침 (스캔 루프 대신 패킹 때 한 번)
+  for (uint8_t k = 0; k < 4; k++)
+  {
+    out[k] = hub75_px((uint8_t)(w >> (8 * k)));
+  }
+#else
+  memcpy(out, &w, sizeof(w));
+#endif
+}
+
+void hub75_pack_span(hub75_row_t *dst, int col0, int n,
+                     const uint8_t *r_top, const uint8_t *g_top, const uint8_t *b_top,
+                     const uint8_t *r_bot, const uint8_t *g_bot, const uint8_t *b_bot)
+{
+  for (int i = 0; i < n; i += 4)
+  {
+    uint32_t rt = level4(r_top + i);
+    uint32_t gt = level4(g_top + i);
+    uint32_t bt = level4(b_top + i);
+    uint32_t rb = level4(r_bot + i);
+    uint32_t gb = level4(g_bot + i);
+    uint32_t bb = level4(b_bot + i);
+
+    for (uint8_t plane = 0; plane < SCAN_PLANES; plane++)
+    {
+      uint32_t w = ((rt >> plane) & LANE_LSB) |
+                   (((gt >> plane) & LANE_LSB) << 1) |
+                   (((bt >> plane) & LANE_LSB) << 2) |
+                   (((rb >> plane) & LANE_LSB) << 3) |
+                   (((gb >> plane) & LANE_LSB) << 4) |
+                   (((bb >> plane) & LANE_LSB) << 5);
+      store4(&(*dst)[plane][col0 + i], w);
+    }
+  }
+}
+
+void hub75_pack_pixel_ref(hub75_row_t *dst, int col,
+                          uint8_t r_top, uint8_t g_top, uint8_t b_top,
+                          uint8_t r_bot, uint8_t g_bot, uint8_t b_bot)
+{
+  r_top = hub75_level(r_top);
+  g_top = hub75_level(g_top);
+  b_top = hub75_level(b_top);
+  r_bot = hub75_level(r_bot);
+  g_bot = hub75_level(g_bot);
+  b_bot = hub75_level(b_bot);
+
+  for (uint8_t plane = 0; plane < SCAN_PLANES; plane++)
+  {
+    uint8_t val = 0;
+
+    if (r_top & 1) val |= 0x01;
+    if (g_top & 1) val |= 0x02;
+    if (b_top & 1) val |= 0x04;
+
+    if (r_bot & 1) val |= 0x08;
+    if (g_bot & 1) val |= 0x10;
+    if (b_bot & 1) val |= 0x20;
+
+    (*dst)[plane][col] = hub75_px(val);
+
+    r_top >>= 1;
+    g_top >>= 1;
+    b_top >>= 1;
+    r_bot >>= 1;
+    g_bot >>= 1;
+    b_bot >>= 1;
+  }
+}
+
+#ifdef HUB75_PACK_BENCH
+// 호스트 벤치마크: 기존 픽셀 단위 패킹 vs 4픽셀 워드 커널
+//   gcc -O2 -DHOST_BUILD -DHUB75_PACK_BENCH hub75_pack.c hub75.c hub75_rec.c prof.c -o hub75_pack
+// 무작위 채널값으로 16 주소 전체를 패킹하고, 결과가 바이트 단위로 같은지 확인
+#include <stdio.h>
+#include <stdlib.h>
+#include "prof.h"
+#include "hub75_hw.h"
+
+#define BENCH_ROUNDS 2000
+
+static uint8_t src[SCAN_LINES][6][PANEL_WIDTH_TOTAL];
+static hub75_row_t out_ref[SCAN_LINES], out_span[SCAN_LINES];
+
+int main(void)
+{
+  srand(1);
+  for (int a = 0; a < SCAN_LINES; a++)
+    for (int c = 0; c < 6; c++)
+      for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
+        src[a][c][x] = (uint8_t)rand();
+
+  uint32_t t0 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (int a = 0; a < SCAN_LINES; a++)
+      for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
+        hub75_pack_pixel_ref(&out_ref[a], x, src[a][0][x], src[a][1][x], src[a][2][x],
+                             src[a][3][x], src[a][4][x], src[a][5][x]);
+  uint32_t t1 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS; k++)
+    for (int a = 0; a < SCAN_LINES; a++)
+      hub75_pack_span(&out_span[a], 0, PANEL_WIDTH_TOTAL, src[a][0], src[a][1], src[a][2],
+                      src[a][3], src[a][4], src[a][5]);
+  uint32_t t2 = prof_now();
+
+  int same = memcmp(out_ref, out_span, sizeof(out_ref)) == 0;
+  // prof_now() 는 호스트에서 ns
+  double ref = (t1 - t0) / 1e3 / BENCH_ROUNDS, span = (t2 - t1) / 1e3 / BENCH_ROUNDS;
+  printf("SCAN_PLANES %d, 1 frame (%d addr x %d col)\n", SCAN_PLANES, SCAN_LINES, PANEL_WIDTH_TOTAL);
+  printf("  per-pixel ref : %8.2f us\n", ref);
+  printf("  word kernel   : %8.2f us  (x%.1f)\n", span, ref / span);
+  printf("  output %s\n", same ? "identical" : "MISMATCH");
+
+  // 스캔 루프 컬럼 하나: ODR 읽기-수정-쓰기 vs BSRR 저장 (CLK 쓰기 두 번은 같음)
+  // 호스트의 volatile 읽기는 L1 히트라서 AHB 레지스터 읽기보다 훨씬 싸다 → 보드에서는 차이가 더 큼
+  static volatile uint32_t odr_a, bsrr_a, bsrr_b;
+  static uint8_t row8[PANEL_WIDTH_TOTAL];
+  static uint32_t row32[PANEL_WIDTH_TOTAL];
+  for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
+  {
+    row8[x] = src[0][0][x] & RGB_MASK;
+    row32[x] = row8[x] | ((uint32_t)(~row8[x] & RGB_MASK) << 16);
+  }
+  uint32_t t3 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS * 100; k++)
+    for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
+    {
+      bsrr_b = PIN_CLK << 16;
+      odr_a = (odr_a & ~RGB_MASK) | (row8[x] & RGB_MASK);
+      bsrr_b = PIN_CLK;
+    }
+  uint32_t t4 = prof_now();
+  for (int k = 0; k < BENCH_ROUNDS * 100; k++)
+    for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
+    {
+      bsrr_b = PIN_CLK << 16;
+      bsrr_a = row32[x];
+      bsrr_b = PIN_CLK;
+    }
+  uint32_t t5 = prof_now();
+  (void)(odr_a + bsrr_a + bsrr_b); // 레지스터 대역을 한 번 읽어서 "쓰기만 한 변수" 경고를 막음
+  double cols = (double)BENCH_ROUNDS * 100 * PANEL_WIDTH_TOTAL;
+  double odr = (t4 - t3) / cols, bsrr = (t5 - t4) / cols;
+  printf("scan column (host, CLK low/data/CLK high)\n");
+  printf("  ODR rmw       : %8.3f ns\n", odr);
+  printf("  BSRR store    : %8.3f ns  (x%.2f)\n", bsrr, odr / bsrr);
+  return same ? 0 : 1;
+}
+#endif
@@ -0,0 +1,21 @@
+#ifndef _HUB75_PACK_H_
+#define _HUB75_PACK_H_
+
+// 픽셀 → BAM plane 패킹 커널
+// 상단/하단 RGB 8비트 채널 배열을 감마 보정 후 hub75_row_t 의 [plane][col] 바이트로 변환
+// 4픽셀을 32비트 워드 하나로 묶어서(바이트 레인 = 픽셀) 분기 없이 plane 비트를 뽑는다
+
+#include "hub75.h"
+
+// dst[plane][col0 .. col0+n-1] 에 기록, n 은 4의 배수
+// 채널 포인터는 각각 연속된 n 바이트 (row_t 의 r/g/b 배열 그대로)
+void hub75_pack_span(hub75_row_t *dst, int col0, int n,
+                     const uint8_t *r_top, const uint8_t *g_top, const uint8_t *b_top,
+                     const uint8_t *r_bot, const uint8_t *g_bot, const uint8_t *b_bot);
+
+// 기존 픽셀 단위 패킹 (한 plane 당 비트 검사 6번), 비교/벤치마크용
+void hub75_pack_pixel_ref(hub75_row_t *dst, int col,
+                          uint8_t r_top, uint8_t g_top, uint8_t b_top,
+                          uint8_t r_bot, uint8_t g_bot, uint8_t b_bot);
+
+#endif
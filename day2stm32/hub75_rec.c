@@ -0,0 +1,221 @@
+// 호스트용 HUB75 레지스터 쓰기 기록기
+//
+// 빌드 예 (PC):
+//   gcc -DHOST_BUILD -DHUB75_REC_MAIN hub75.c hub75_rec.c prof.c -o hub75_rec
+//   ./hub75_rec > trace.txt
+//
+// 모델링하는 하드웨어 동작
+//  - GPIOx->BSRR : ODR 에 set/reset 반영
+//  - TIMx->SR    : rc_w0 (0 쓴 비트만 지워짐)
+//  - TIM1 CEN    : DMA2 Stream1 이 NDTR 바이트를 GPIOA->ODR[7:0] 로 한 주기(ARR+1)씩 전송,
+//                  TIM4 CLK 상승 에지 횟수를 세고, 전송이 끝나는 시각에 TIM1 update 인터럽트
+//  - TIM3 CEN    : CH2(OE) 가 켜져 있으면 ARR-CCR2+1 tick 동안 OE Low,
+//                  ARR+1 tick 뒤 TIM3 update 인터럽트
+// TIM1 전송과 TIM3 펄스는 동시에 진행될 수 있고, hub75_rec_run 은 먼저 끝나는 쪽부터 처리
+#ifdef HOST_BUILD
+
+#include "hub75_hw.h"
+#include "hub75.h"
+#include "prof.h"
+#include <stdlib.h>
+
+GPIO_TypeDef host_gpioa, host_gpiob;
+TIM_TypeDef host_tim1, host_tim3, host_tim4;
+DMA_Stream_TypeDef host_dma2_stream1;
+DMA_TypeDef host_dma2;
+RCC_TypeDef host_rcc;
+
+void TIM1_UP_TIM10_IRQHandler(void);
+void TIM3_IRQHandler(void);
+
+static hub75_rec_t rec_log[HUB75_REC_MAX];
+static uint32_t rec_count = 0;
+static uint64_t rec_tick = 0;
+static uint8_t tim1_pending = 0;
+static uint8_t tim3_pending = 0;
+static uint64_t tim1_due = 0;
+static uint64_t tim3_due = 0;
+static uint32_t clk_edges = 0;
+static uint64_t oe_ticks = 0;
+
+static void rec_push_at(uint64_t tick, const char *name, uintptr_t val)
+{
+  if (rec_count == HUB75_REC_MAX) return;
+  rec_log[rec_count].tick = tick;
+  rec_log[rec_count].reg = name;
+  rec_log[rec_count].val = val;
+  rec_count++;
+}
+
+static void rec_push(const char *name, uintptr_t val) { rec_push_at(rec_tick, name, val); }
+
+// TIM1 시작 : DMA 가 주기마다 1바이트씩 GPIOA 로
+static void tim1_begin(void)
+{
+  uint32_t n = (uint32_t)host_dma2_stream1.NDTR;
+  const uint8_t *src = (const uint8_t *)host_dma2_stream1.M0AR;
+  uint32_t period = (uint32_t)host_tim1.ARR + 1;
+
+  if (!(host_dma2_stream1.CR & DMA_SxCR_EN)) n = 0;
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    rec_push_at(rec_tick + (uint64_t)i * period, "DMA2_Stream1 -> GPIOA->ODR[7:0]", src[i]);
+    clk_edges++;
+  }
+  host_gpioa.ODR = (host_gpioa.ODR & ~0xFFu) | (n ? src[n - 1] : 0);
+  host_dma2_stream1.NDTR = 0;
+
+  tim1_pending = 1;
+  tim1_due = rec_tick + (uint64_t)(host_tim1.RCR + 1) * period;
+}
+
+// TIM3 시작 : OE one-pulse
+static void tim3_begin(void)
+{
+  if (host_tim3.CCER & TIM_CCER_CC2E)
+  {
+    rec_push("TIM3_CH2 -> OE Low (ticks)", host_tim3.ARR - host_tim3.CCR2 + 1);
+    oe_ticks += host_tim3.ARR - host_tim3.CCR2 + 1;
+  }
+  tim3_pending = 1;
+  tim3_due = rec_tick + host_tim3.ARR + 1;
+}
+
+void hub75_rec_write(volatile uintptr_t *reg, uintptr_t val, const char *name)
+{
+  if (reg == &host_tim1.SR || reg == &host_tim3.SR || reg == &host_tim4.SR)
+  {
+    *reg &= val; // rc_w0
+  }
+  else if (reg == &host_gpioa.BSRR || reg == &host_gpiob.BSRR)
+  {
+    GPIO_TypeDef *g = (reg == &host_gpioa.BSRR) ? &host_gpioa : &host_gpiob;
+    g->ODR = (g->ODR | (val & 0xFFFFu)) & ~((val >> 16) & 0xFFFFu);
+#if !HUB75_USE_DMA
+    // CPU 스캔 : CLK 상승마다 컬럼 한 개 분량의 시간이 흐름
+    if (g == &host_gpiob && val == PIN_CLK)
+    {
+      clk_edges++;
+      rec_tick += HUB75_CPU_COL_TICKS;
+    }
+#endif
+  }
+  else
+  {
+    *reg = val;
+  }
+  rec_push(name, val);
+
+  if (reg == &host_tim1.CR1 && (val & TIM_CR1_CEN)) tim1_begin();
+  if (reg == &host_tim3.CR1 && (val & TIM_CR1_CEN)) tim3_begin();
+}
+
+// CPU 스캔 빌드에는 TIM1 핸들러가 없음 (tim1_pending 도 켜지지 않음)
+static void tim1_irq(void)
+{
+#if HUB75_USE_DMA
+  TIM1_UP_TIM10_IRQHandler();
+#endif
+}
+
+uint32_t hub75_rec_run(uint32_t max_irqs)
+{
+  uint32_t n = 0;
+  while (n < max_irqs && (tim1_pending || tim3_pending))
+  {
+    if (tim1_pending && (!tim3_pending || tim1_due <= tim3_due))
+    {
+      tim1_pending = 0;
+      rec_tick = tim1_due;
+      host_tim1.CR1 &= ~TIM_CR1_CEN;
+      host_tim1.SR |= TIM_SR_UIF;
+      tim1_irq();
+    }
+    else
+    {
+      tim3_pending = 0;
+      if (rec_tick < tim3_due) rec_tick = tim3_due; // CPU 스캔이 펄스보다 길면 이미 지나 있음
+      host_tim3.CR1 &= ~TIM_CR1_CEN;
+      host_tim3.SR |= TIM_SR_UIF;
+      TIM3_IRQHandler();
+    }
+    n++;
+  }
+  return n;
+}
+
+void hub75_rec_clear(void)
+{
+  rec_count = 0;
+  rec_tick = 0;
+  clk_edges = 0;
+  oe_ticks = 0;
+}
+
+uint32_t hub75_rec_count(void) { return rec_count; }
+const hub75_rec_t *hub75_rec_get(uint32_t i) { return (i < rec_count) ? &rec_log[i] : 0; }
+uint64_t hub75_rec_ticks(void) { return rec_tick; }
+
+static int rec_cmp(const void *a, const void *b)
+{
+  const hub75_rec_t *x = a, *y = b;
+  if (x->tick != y->tick) return (x->tick < y->tick) ? -1 : 1;
+  return (x < y) ? -1 : 1; // 같은 시각이면 기록 순서
+}
+
+// 시각 순으로 정렬해서 출력 (DMA 바이트는 전송 시작 때 미리 기록되므로)
+void hub75_rec_dump(FILE *f)
+{
+  qsort(rec_log, rec_count, sizeof(rec_log[0]), rec_cmp);
+  for (uint32_t i = 0; i < rec_count; i++)
+  {
+    fprintf(f, "%10llu  %-34s 0x%08lx\n",
+            (unsigned long long)rec_log[i].tick, rec_log[i].reg,
+            (unsigned long)rec_log[i].val);
+  }
+}
+
+#ifdef HUB75_REC_MAIN
+// 스캔 시퀀스를 출력하고, 두 번째 프레임(파이프라인이 찬 상태)부터 디더 주기(2^D 프레임) 동안의
+// CLK 수/OE 시간/프레임 시간을 검사
+int main(void)
+{
+  for (int a = 0; a < SCAN_LINES; a++)
+    for (int p = 0; p < SCAN_PLANES; p++)
+      for (int c = 0; c < PANEL_WIDTH_TOTAL; c++)
+        scan_buf[0][a][p][c] = hub75_px((uint8_t)((a + p + c) & RGB_MASK));
+
+  prof_init();
+  hub75_init();
+  hub75_rec_clear();
+  hub75_start();
+  while (hub75_frame_count() == 0 && hub75_rec_run(1))
+    ;
+  uint64_t t0 = hub75_rec_ticks(), oe0 = oe_ticks;
+  uint32_t clk0 = clk_edges;
+  const uint32_t frames = 1u << HUB75_DITHER_BITS;
+  while (hub75_frame_count() <= frames && hub75_rec_run(1))
+    ;
+  hub75_stop();
+
+  hub75_rec_dump(stdout);
+  prof_print(); // 호스트 clock_gettime 기준 (인터럽트 코드 자체의 실행 시간, 시뮬레이션 tick 아님)
+
+  uint32_t clk = clk_edges - clk0;
+  uint64_t oe = oe_ticks - oe0, ticks = hub75_rec_ticks() - t0;
+  // 주기마다 BAM plane 은 frames 번, 디더 plane 은 frames - 1 번 (plane 0 폭)
+  uint32_t shows = BAM_PLANES * frames + (frames - 1);
+  uint32_t expect = SCAN_LINES * shows * PANEL_WIDTH_TOTAL;
+  uint64_t oe_expect = (uint64_t)SCAN_LINES * HUB75_HOLD_BASE * (((1u << BAM_PLANES) - 1) * frames + (frames - 1));
+  double sec = (double)ticks / 84e6 / frames;
+  fprintf(stderr, "CLK edges %u (expect %u), OE on %llu ticks (expect %llu, duty %.1f%%), frame %.1f us, refresh %.1f Hz\n",
+          clk, expect, (unsigned long long)oe, (unsigned long long)oe_expect,
+          100.0 * (double)oe / (double)ticks, sec * 1e6, 1.0 / sec);
+  for (uint8_t p = 1; p <= 8 - HUB75_DITHER_BITS; p++)
+    fprintf(stderr, "  %u planes : %4u Hz%s\n", p, hub75_refresh_hz(p), p == BAM_PLANES ? "  <- build" : "");
+  return (clk == expect && oe == oe_expect) ? 0 : 1;
+}
+#endif
+
+#endif /* HOST_BUILD */
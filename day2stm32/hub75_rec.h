@@ -0,0 +1,30 @@
+#ifndef _HUB75_REC_H_
+#define _HUB75_REC_H_
+
+// 호스트용 레지스터 쓰기 기록기 (HOST_BUILD 전용)
+// hub75_hw.h 의 HW_WR() 이 여기로 들어오고, TIM1/DMA/TIM3 동작을 흉내내서
+// 보드 없이 한 프레임 동안의 핀/레지스터 시퀀스를 뽑아볼 수 있다
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef HUB75_REC_MAX
+#define HUB75_REC_MAX 65536
+#endif
+
+typedef struct
+{
+  uint64_t tick;    // 시뮬레이션 시간 (84MHz 타이머 tick)
+  const char *reg;  // 레지스터 이름 ("GPIOB->BSRR" 등)
+  uintptr_t val;    // 쓴 값
+} hub75_rec_t;
+
+void hub75_rec_write(volatile uintptr_t *reg, uintptr_t val, const char *name);
+void hub75_rec_clear(void);
+uint32_t hub75_rec_count(void);
+const hub75_rec_t *hub75_rec_get(uint32_t i);
+uint64_t hub75_rec_ticks(void);
+uint32_t hub75_rec_run(uint32_t max_irqs); // 대기 중인 인터럽트를 차례로 실행
+void hub75_rec_dump(FILE *f);
+
+#endif
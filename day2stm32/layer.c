@@ -1,4 +1,5 @@
 #include "layer.h"
+#include "3d.h"
 
 layer_t layers[MAX_LAYER];
 static uint8_t layer_amount = 0;
@@ -106,6 +107,42 @@ row_t layer_capture_row(int r)
   return row;
 }
 
+// layer_capture_row 와 같은 합성을 채널 비트 3개로 (켜진 채널만 255 라서 픽셀당 8색)
+void layer_draw_row(int r)
+{
+  uint8_t px[64] = {0}; // bit0 R, bit1 G, bit2 B
+
+  for (int li = 0; li < layer_amount; ++li)
+  {
+    layer_t *L = &layers[li];
+    int rel_y = r - (L->y - 3);
+    if (rel_y < 0 || rel_y >= 7) continue;
+
+    int left = L->x - 3;
+    for (int sx = 0; sx < 8; ++sx)
+    {
+      int x = left + sx;
+      if (x < 0 || x >= 64) continue;
+
+      uint8_t mask = 1u << (7 - sx);
+      if (L->r[rel_y] & mask) px[x] |= 1;
+      if (L->g[rel_y] & mask) px[x] |= 2;
+      if (L->b[rel_y] & mask) px[x] |= 4;
+    }
+  }
+
+  // 같은 색이 이어지는 구간마다 fb_hline() 한 번 (대부분 검정 구간 몇 개)
+  uint8_t indexed = render_get_format() == FB_INDEXED;
+  for (int x0 = 0, x1; x0 < 64; x0 = x1 + 1)
+  {
+    uint8_t c = px[x0];
+    for (x1 = x0; x1 + 1 < 64 && px[x1 + 1] == c; ++x1)
+      ;
+    uint32_t rgb = ((c & 1) ? 0xFF0000u : 0) | ((c & 2) ? 0x00FF00u : 0) | ((c & 4) ? 0x0000FFu : 0);
+    fb_hline(x0, x1, r, indexed ? c : rgb);
+  }
+}
+
 void layer_add(layer_t l)
 {
   layers[layer_amount++] = l;
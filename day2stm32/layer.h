@@ -35,6 +35,7 @@ typedef struct
 void layer_clear(void);
 uint64_t layer_move(void); // 레이어 이동 반영 후 업데이트된 row를 64비트 형태로 반환
 row_t layer_capture_row(int r);
+void layer_draw_row(int r); // row r 을 합성해서 fb_hline() 으로 (3d.h 의 현재 형식, FB_INDEXED 면 색 번호 = bit0 R, bit1 G, bit2 B)
 void layer_add(layer_t l);
 void layer_add_random(void);
 
@@ -22,6 +22,14 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include <string.h>
+#include "hub75.h"
+#include "hub75_pack.h"
+#include "hub75_map.h"
+#include "prof.h"
+#include "anim.h"
+#include "blit.h"
+#include "fbpal.h"
+#include "bitfb.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -31,21 +39,22 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-// --- PIN DEFINITIONS ---
-// RGB Data: PA0~PA5
-#define RGB_MASK 0x003F
-// Address: PA8~PA11 (A, B, C, D)
-#define ADDR_MASK 0x0F00
-#define ADDR_SHIFT 8
-
-// Control Pins (Port B)
-#define PIN_OE GPIO_PIN_5
-#define PIN_CLK GPIO_PIN_7
-#define PIN_LAT GPIO_PIN_8
-
-// --- SETTINGS ---
-#define PANEL_WIDTH_TOTAL 128 // 64픽셀 패널 2개 연결
-#define BAM_DELAY_BASE 40     // 84MHz 기준 밝기 딜레이
+// 핀/패널 설정은 hub75.h, 패널 배치/회전/채널 순서는 hub75_map.h
+#define PROF_PRINT_FRAMES 0 // >0 이면 스캔 프레임 N장마다 prof_print() (printf → UART), 0 이면 디버거로 prof_stats 확인
+#define LAYER_MOVE_FRAMES 5 // 레이어 모드: 리프레시 프레임 5장마다 한 칸 이동 (330Hz 기준 약 66회/초)
+#define CUBE_SPIN_X 0.9f  // 큐브 회전 속도 (rad/s), 예전 루프당 0.015 / 0.021 을 60fps 로 본 값
+#define CUBE_SPIN_Y 1.26f
+#define CUBE_DIRTY_RECT 1 // 1: 큐브 모드에서 지난/이번 프레임에 그린 사각형만 지우고 그 주소/컬럼만 다시 패킹
+// 레이어 모드 그리기 대상 (3d.h fb_format_t)
+// 0: RGB fb (밴드 빌드면 패킹할 때 합성), 1: 팔레트 fb (fbpal, 8색) 에 그리고 LUT 로 패킹
+// 2: 스캔 back 버퍼에 바로 (bitfb, fb 도 패킹도 없음)
+#define LAYER_FB 1
+#if LAYER_FB == 1 && !RENDER_FBPAL
+#error "LAYER_FB 1 needs RENDER_FBPAL=1"
+#endif
+#if LAYER_FB == 2 && !RENDER_BITFB
+#error "LAYER_FB 2 needs RENDER_BITFB=1"
+#endif
 
 /* USER CODE END PD */
 
@@ -59,10 +68,14 @@ TIM_HandleTypeDef htim3;
 
 /* USER CODE BEGIN PV */
 // 애니메이션 시작 색상 인덱스 (가로 쉬프트 효과를 위한 전역 변수)
-uint8_t row_buffer[384]; // 128 pixel * 3 planes
 uint32_t timer_tick = 0;
 uint8_t test_mode = 0;
 row_t scan_rows[4];
+#if RENDER_BANDS
+// 밴드 b = 스캔 주소 b × RENDER_BAND_ADDRS 부터 RENDER_BAND_ADDRS 개, 주소마다 HUB75_BAND_ROWS 개 row
+#define BAND_COUNT (SCAN_LINES / RENDER_BAND_ADDRS)
+uint8_t band_y[BAND_COUNT][RENDER_BAND_ROWS];
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -70,20 +83,17 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_TIM3_Init(void);
 /* USER CODE BEGIN PFP */
-void delay_cycles(uint32_t count);
-void render_row(uint8_t row);
 void update_buffer_pattern(uint8_t row);
 void update_buffer_from_frame(uint8_t row);
-void update_buffer_from_layers(uint8_t rowAddr);
 void process_layer_update(uint64_t layer_update);
 void hub75_update_from_layers(uint64_t layer_update);
+#if RENDER_BANDS
+void pack_band(uint8_t band, const row_t *rows);
+#endif
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-#define PANEL_WIDTH 64 // 가로 64컬럼
-#define PANEL_WIDTH_TOTAL 128
-
 // ---- 핀 제어 헬퍼 ----
 static inline void set_color_top_raw(uint8_t r, uint8_t g, uint8_t b)
 {
@@ -172,8 +182,7 @@ int main(void)
   MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
 
-  // 2. TIM1 Channel 3 (PA10, HUB75 OE 핀) PWM 출력 시작
-  // HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
+  // 2. OE(PB5) = TIM3 CH2 출력 → hub75_init() 에서 one-pulse 모드로 설정
 
   /* USER CODE END 2 */
 
@@ -182,29 +191,105 @@ int main(void)
   oe_off();
   HAL_GPIO_WritePin(CLK_GPIO_Port, CLK_Pin, GPIO_PIN_RESET);
   HAL_GPIO_WritePin(LAT_GPIO_Port, LAT_Pin, GPIO_PIN_RESET);
+  hub75_geom_t geom;
+  hub75_geom_default(&geom); // 배치가 다르면 여기서 chain/rotate/mirror/ch_* 수정
+  hub75_map_init(&geom);
+#if RENDER_FBPAL
+  fbpal_init(); // 팔레트 LUT 에 채널 순서가 들어가므로 배치 뒤에
+#endif
+#if RENDER_BITFB
+  bitfb_init(); // 픽셀 → 스캔 칸 표도 배치 뒤에
+#endif
+#if RENDER_BANDS
+  // 주소 하나가 fb row 에 대응하는 배치 (rotate 0/2) 여야 밴드로 그릴 수 있음
+  if (HUB75_BAND_ROWS * RENDER_BAND_ADDRS > RENDER_BAND_ROWS || SCAN_LINES % RENDER_BAND_ADDRS) Error_Handler();
+  for (uint8_t a = 0; a < SCAN_LINES; a++)
+  {
+    if (!hub75_band_rows(a, &band_y[a / RENDER_BAND_ADDRS][(a % RENDER_BAND_ADDRS) * HUB75_BAND_ROWS])) Error_Handler();
+  }
+#endif
+  prof_init();
+  blit_init(); // fb 지우기 DMA (RENDER_DMA_CLEAR)
+  hub75_init();
+  hub75_start(); // 이후 패널 리프레시는 타이머 인터럽트가 백그라운드로 진행
   float ax = 0, ay = 0;
+  anim_clock_t anim;
+  anim_init(&anim);
   uint8_t prevsw = -1;
-  uint16_t update_count = 0;
+  uint32_t layer_frame = 0; // 마지막으로 레이어를 움직인 스캔 프레임 번호
   uint8_t mode = 0; // 0: cube, 1: layer
-  uint8_t cubestop = 0;
+  uint8_t cubestop = 0; // 1: 현재 각도의 큐브가 이미 스캔 버퍼에 있음 (렌더/패킹 생략)
+  uint8_t cubefull = 1; // 1: fb/스캔 버퍼에 큐브가 아닌 것이 있을 수 있음 (시작, 레이어 모드 뒤) → 전체 지우기
+#if CUBE_DIRTY_RECT && !RENDER_BANDS
+  fb_rect_t back_rect = {0, 0, -1, -1}; // 지난 프레임 패킹 사각형 = back 버퍼가 가진 프레임 이후 바뀐 곳
+#else
+  (void)cubefull; // 매 프레임 전체를 다시 그리는 경로
+#endif
   uint64_t update_flag = 0;
+#if PROF_PRINT_FRAMES
+  uint32_t prof_frame = 0;
+#endif
   while (1)
   {
+    // 버튼과 상관없이 시계는 계속 흘려 보냄 (누르는 순간 밀린 시간만큼 튀지 않게)
+    uint8_t steps = anim_update(&anim);
+
     // cube
     if (mode == 0)
     {
-      clear_framebuffer();
-      render_cube_frame(ax, ay);
-      for (uint8_t row = 0; row < 16; row++)
+      // 각도가 그대로면 스캔 버퍼도 그대로 → 렌더링/패킹 모두 건너뜀
+      if (!cubestop)
       {
-        update_buffer_from_frame(row);
-        render_row(row); // 패널 전송
+        uint32_t t = prof_now(), t_frame = t;
+#if RENDER_BANDS
+        // fb/clear 없이 밴드마다 그리고 바로 back 버퍼에 패킹 (render 구간에 pack 포함)
+        render_cube_bands(ax, ay, (const uint8_t(*)[RENDER_BAND_ROWS])band_y, BAND_COUNT,
+                          HUB75_BAND_ROWS * RENDER_BAND_ADDRS, pack_band);
+        prof_lap(PROF_RENDER, &t);
+#elif CUBE_DIRTY_RECT
+        if (cubefull) clear_framebuffer(); // 이번과 다음 프레임은 화면 전체를 다시 패킹
+        else clear_framebuffer_dirty();
+        prof_lap(PROF_CLEAR, &t);
+        render_cube_frame(ax, ay);
+        prof_lap(PROF_RENDER, &t);
+        // back 버퍼는 두 프레임 전 것이므로 지난번 사각형까지 합쳐서 다시 패킹
+        fb_rect_t dirty = render_dirty_rect();
+        fb_rect_t pack = fb_rect_union(dirty, back_rect);
+        back_rect = dirty;
+        uint32_t addr_mask = 0;
+        for (int y = pack.y0; y <= pack.y1 && pack.x0 <= pack.x1; y++)
+        {
+          addr_mask |= hub75_map_row_addrs((uint8_t)y);
+        }
+        hub75_pack_frame_dirty(hub75_back(), addr_mask, (const uint8_t *)fb, (uint8_t)pack.x0, (uint8_t)pack.x1);
+        prof_lap(PROF_PACK, &t);
+#else
+        clear_framebuffer();
+        prof_lap(PROF_CLEAR, &t);
+        render_cube_frame(ax, ay);
+        prof_lap(PROF_RENDER, &t);
+        for (uint8_t row = 0; row < SCAN_LINES; row++)
+        {
+          update_buffer_from_frame(row); // back 버퍼에 패킹
+        }
+        prof_lap(PROF_PACK, &t);
+#endif
+        hub75_swap(); // vsync 에서 front 교체
+        prof_lap(PROF_SWAP, &t);
+        prof_add(PROF_FRAME, t - t_frame);
+        anim_frame(&anim);
+        cubestop = 1;
+        cubefull = 0;
       }
-      oe_off();
       if (HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_0) == GPIO_PIN_RESET)
       {
-        ax += 0.015f;
-        ay += 0.021f;
+        // 고정 간격 스텝만큼 회전 → 렌더가 느려지거나 빨라져도 초당 각도는 같음
+        for (uint8_t i = 0; i < steps; i++)
+        {
+          ax += CUBE_SPIN_X * ANIM_DT;
+          ay += CUBE_SPIN_Y * ANIM_DT;
+        }
+        if (steps) cubestop = 0;
         prevsw = 0;
       }
       else if (HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_1) == GPIO_PIN_RESET)
@@ -213,6 +298,16 @@ int main(void)
         {
           prevsw = 1;
           mode = 1;
+#if LAYER_FB == 1
+          render_set_format(FB_INDEXED); // 레이어는 put_pixel() 로 팔레트 fb 에
+          fbpal_clear(0);
+#elif LAYER_FB == 2
+          render_set_format(FB_BITPLANE); // 아래 hub75_clear() 가 두 버퍼 모두 지움
+#elif !RENDER_BANDS
+          clear_framebuffer(); // 레이어 모드는 바뀐 row 만 fb 에 다시 그리므로 큐브 잔상 제거
+          render_clear_wait(); // 레이어가 fb 에 직접 쓰므로 DMA 지우기가 끝난 뒤로
+#endif
+          hub75_clear();
         }
       }
       else prevsw = -1;
@@ -236,16 +331,32 @@ int main(void)
           prevsw = 1;
           layer_clear();
           mode = 0;
+#if LAYER_FB
+          render_set_format(FB_RGB);
+#endif
+          cubestop = 0; // 스캔 버퍼에 레이어 화면이 남아 있으므로 다시 그림
+          cubefull = 1;
         }
       }
       else prevsw = -1;
-      if (update_count++ == 16000)
+      // 패널은 백그라운드에서 계속 리프레시되고, 이동 속도만 스캔 프레임 수로 맞춤
+      if (hub75_frame_count() - layer_frame >= LAYER_MOVE_FRAMES)
       {
-        update_count = 0;
+        layer_frame = hub75_frame_count();
+        uint32_t t = prof_now();
         update_flag = layer_move();
         hub75_update_from_layers(update_flag);
+        prof_add(PROF_LAYER, prof_now() - t);
       }
     }
+
+#if PROF_PRINT_FRAMES
+    if (hub75_frame_count() - prof_frame >= PROF_PRINT_FRAMES)
+    {
+      prof_frame = hub75_frame_count();
+      prof_print();
+    }
+#endif
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -392,61 +503,11 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
-// --- Helper Functions ---
-void delay_cycles(uint32_t count)
-{
-  while (count--)
-  {
-    __asm("nop");
-  }
-}
-
-// --- Render Logic (Direct Register Access) ---
-void render_row(uint8_t row)
-{
-  // 1. OE High (LED Off)
-  GPIOB->BSRR = PIN_OE;
-
-  // 2. Set Row Address (PA8~11)
-  GPIOA->ODR = (GPIOA->ODR & ~ADDR_MASK) | ((row & 0x0F) << ADDR_SHIFT);
-
-  // 3. BAM (Bit Angle Modulation)
-  for (uint8_t plane = 0; plane < 3; plane++)
-  {
-    uint8_t *ptr = &row_buffer[plane * PANEL_WIDTH_TOTAL];
-
-    for (uint8_t col = 0; col < PANEL_WIDTH_TOTAL; col++)
-    {
-      GPIOB->BSRR = (PIN_CLK << 16); // CLK Low
-
-      // Set RGB Data (PA0~5)
-      GPIOA->ODR = (GPIOA->ODR & ~RGB_MASK) | (*ptr++ & RGB_MASK);
-
-      GPIOB->BSRR = PIN_CLK; // CLK High
-    }
-
-    // Latch Data
-    GPIOB->BSRR = PIN_LAT;
-    GPIOB->BSRR = (PIN_LAT << 16);
-
-    // OE Low (Display On)
-    GPIOB->BSRR = (PIN_OE << 16);
-
-    delay_cycles(BAM_DELAY_BASE * (1 << plane));
-
-    // OE High (Display Off)
-    GPIOB->BSRR = PIN_OE;
-  }
-}
-
 // --- Test Pattern Logic ---
 void update_buffer_pattern(uint8_t row)
 {
-  memset(row_buffer, 0, sizeof(row_buffer));
-
-  uint8_t *p0 = &row_buffer[0];
-  uint8_t *p1 = &row_buffer[PANEL_WIDTH_TOTAL];
-  uint8_t *p2 = &row_buffer[PANEL_WIDTH_TOTAL * 2];
+  hub75_row_t *dst = &hub75_back()[row];
+  uint8_t rs[PANEL_WIDTH_TOTAL], gs[PANEL_WIDTH_TOTAL], bs[PANEL_WIDTH_TOTAL];
 
   for (int x = 0; x < PANEL_WIDTH_TOTAL; x++)
   {
@@ -455,257 +516,125 @@ void update_buffer_pattern(uint8_t row)
     switch (test_mode)
     {
     case 0:
-      r = 7;
+      r = 255;
       break; // RED
     case 1:
-      g = 7;
+      g = 255;
       break; // GREEN
     case 2:
-      b = 7;
+      b = 255;
       break; // BLUE
     case 3:
-      r = 7;
-      g = 7;
-      b = 7;
+      r = 255;
+      g = 255;
+      b = 255;
       break; // WHITE
     case 4:  // Gradient
       if (x < 42)
       {
-        r = x % 8;
+        r = (x % 8) * 36;
       }
       else if (x < 84)
       {
-        g = x % 8;
+        g = (x % 8) * 36;
       }
       else
       {
-        b = x % 8;
+        b = (x % 8) * 36;
       }
       break;
     }
 
-    uint8_t val0 = 0, val1 = 0, val2 = 0;
-    // 상단(Row), 하단(Row+16) 동시 제어 매핑
-    if (r & 1) val0 |= 0x09;
-    if (g & 1) val0 |= 0x12;
-    if (b & 1) val0 |= 0x24;
-    if (r & 2) val1 |= 0x09;
-    if (g & 2) val1 |= 0x12;
-    if (b & 2) val1 |= 0x24;
-    if (r & 4) val2 |= 0x09;
-    if (g & 4) val2 |= 0x12;
-    if (b & 4) val2 |= 0x24;
-
-    *p0++ = val0;
-    *p1++ = val1;
-    *p2++ = val2;
+    rs[x] = r;
+    gs[x] = g;
+    bs[x] = b;
   }
+
+  // 상단(Row), 하단(Row+16) 동시 제어 매핑
+  hub75_pack_span(dst, 0, PANEL_WIDTH_TOTAL, rs, gs, bs, rs, gs, bs);
 }
 
-#define PANEL_WIDTH 64        // 패널 한 개 가로
-#define PANEL_WIDTH_TOTAL 128 // 두 개 캐스케이드
-#define PANEL_HEIGHT 64       // 논리 해상도
-#define SCAN_LINES 16         // 1/16 스캔
 // row: 스캔라인 번호 (0 ~ SCAN_LINES-1)
-// 실제로는 위쪽 row, 아래쪽 row+SCAN_LINES 두 줄을 동시에 다룬다고 가정
+// 어느 fb 픽셀이 어느 컬럼/상하단으로 가는지는 hub75_map_init() 의 표가 결정
 void update_buffer_from_frame(uint8_t row)
 {
-  memset(row_buffer, 0, sizeof(row_buffer));
-
-  uint8_t *p0 = &row_buffer[0];                     // plane 0
-  uint8_t *p1 = &row_buffer[PANEL_WIDTH_TOTAL];     // plane 1
-  uint8_t *p2 = &row_buffer[PANEL_WIDTH_TOTAL * 2]; // plane 2
-
-  for (int col = 0; col < PANEL_WIDTH_TOTAL; col++)
+#if RENDER_BANDS
+  // fb 가 없으므로 이 주소가 쓰는 row 들만 레이어에서 바로 합성
+  row_t rows[HUB75_BAND_ROWS];
+  const uint8_t *ys = &band_y[row / RENDER_BAND_ADDRS][(row % RENDER_BAND_ADDRS) * HUB75_BAND_ROWS];
+  for (uint8_t j = 0; j < HUB75_BAND_ROWS; j++)
   {
-
-    int x;
-    uint8_t phys_y_top; // 패널에 실제로 점등되는 y
-    uint8_t phys_y_bot;
-
-    if (col < PANEL_WIDTH)
-    {
-      // 왼쪽 패널
-      x = col - PANEL_WIDTH;
-      phys_y_top = row + 32; // 32~47
-      phys_y_bot = row + 48; // 48~63
-    }
-    else
-    {
-      // 오른쪽 패널
-      x = col;
-      phys_y_top = row;      // 0~15
-      phys_y_bot = row + 16; // 16~31
-    }
-
-    // 여기서 "논리 좌표"로 뒤집기 (위/아래 반전)
-    uint8_t y_top = (PANEL_HEIGHT - 1) - phys_y_top; // 63 - phys_y_top
-    uint8_t y_bot = (PANEL_HEIGHT - 1) - phys_y_bot; // 63 - phys_y_bot
-
-    // 이제 fb는 y=0이 "논리적으로 위쪽"이라고 가정
-    uint8_t r_top = fb[y_top].r[x];
-    uint8_t g_top = fb[y_top].g[x];
-    uint8_t b_top = fb[y_top].b[x];
-
-    uint8_t r_bot = fb[y_bot].g[x];
-    uint8_t g_bot = fb[y_bot].b[x];
-    uint8_t b_bot = fb[y_bot].r[x];
-
-    uint8_t val0 = 0, val1 = 0, val2 = 0;
-
-    // --- 비트 매핑 (기존 테스트 패턴과 동일한 구조) ---
-    // plane 0
-    if (r_top & 1) val0 |= 0x01;
-    if (g_top & 1) val0 |= 0x02;
-    if (b_top & 1) val0 |= 0x04;
-
-    if (r_bot & 1) val0 |= 0x08;
-    if (g_bot & 1) val0 |= 0x10;
-    if (b_bot & 1) val0 |= 0x20;
-
-    // plane 1
-    if (r_top & 2) val1 |= 0x01;
-    if (g_top & 2) val1 |= 0x02;
-    if (b_top & 2) val1 |= 0x04;
-
-    if (r_bot & 2) val1 |= 0x08;
-    if (g_bot & 2) val1 |= 0x10;
-    if (b_bot & 2) val1 |= 0x20;
-
-    // plane 2
-    if (r_top & 4) val2 |= 0x01;
-    if (g_top & 4) val2 |= 0x02;
-    if (b_top & 4) val2 |= 0x04;
-
-    if (r_bot & 4) val2 |= 0x08;
-    if (g_bot & 4) val2 |= 0x10;
-    if (b_bot & 4) val2 |= 0x20;
-
-    *p0++ = val0;
-    *p1++ = val1;
-    *p2++ = val2;
+    rows[j] = layer_capture_row(ys[j]);
   }
+  hub75_pack_band(&hub75_back()[row], (const uint8_t *)rows);
+#else
+  hub75_pack_frame(&hub75_back()[row], row, (const uint8_t *)fb);
+#endif
 }
-// 레이어로부터 해당 scan address(rowAddr)에 필요한 4개 논리 row를 캡처해서
-// HUB75용 row_buffer에 패킹
-void update_buffer_from_layers(uint8_t rowAddr)
+
+#if RENDER_BANDS
+// render_cube_bands() 가 밴드를 다 그릴 때마다: 밴드 안의 주소들을 back 버퍼에 패킹
+void pack_band(uint8_t band, const row_t *rows)
 {
-  // 1. 이 addr에 해당하는 논리 y들
-  uint8_t y2 = rowAddr;      // 위쪽 패널 상단
-  uint8_t y3 = rowAddr + 16; // 위쪽 패널 하단
-  uint8_t y0 = rowAddr + 32; // 아래쪽 패널 상단
-  uint8_t y1 = rowAddr + 48; // 아래쪽 패널 하단
-
-  // 2. 각 row를 layer 시스템에서 캡처
-  row_t row0 = layer_capture_row(y0);
-  row_t row1 = layer_capture_row(y1);
-  row_t row2 = layer_capture_row(y2);
-  row_t row3 = layer_capture_row(y3);
-
-  // 3. HUB75 row_buffer 초기화
-  memset(row_buffer, 0, sizeof(row_buffer));
-
-  uint8_t *p0 = &row_buffer[0];                     // plane 0 (LSB)
-  uint8_t *p1 = &row_buffer[PANEL_WIDTH_TOTAL];     // plane 1
-  uint8_t *p2 = &row_buffer[PANEL_WIDTH_TOTAL * 2]; // plane 2
-
-  for (int col = 0; col < PANEL_WIDTH_TOTAL; col++)
+  for (uint8_t i = 0; i < RENDER_BAND_ADDRS; i++)
   {
-
-    int x;
-    // top/bottom 픽셀의 3bit RGB
-    uint8_t r_top, g_top, b_top;
-    uint8_t r_bot, g_bot, b_bot;
-
-    if (col < PANEL_WIDTH)
-    {
-      // 왼쪽 64픽셀 = 위 패널 (논리 y0,y1)
-      x = col;
-
-      r_top = (row0.r[x] ? 7 : 0);
-      g_top = (row0.g[x] ? 7 : 0);
-      b_top = (row0.b[x] ? 7 : 0);
-
-      r_bot = (row1.r[x] ? 7 : 0);
-      g_bot = (row1.g[x] ? 7 : 0);
-      b_bot = (row1.b[x] ? 7 : 0);
-    }
-    else
-    {
-      // 오른쪽 64픽셀 = 아래 패널 (논리 y2,y3)
-      x = col - PANEL_WIDTH;
-
-      r_top = (row2.r[x] ? 7 : 0);
-      g_top = (row2.g[x] ? 7 : 0);
-      b_top = (row2.b[x] ? 7 : 0);
-
-      r_bot = (row3.r[x] ? 7 : 0);
-      g_bot = (row3.g[x] ? 7 : 0);
-      b_bot = (row3.b[x] ? 7 : 0);
-    }
-
-    uint8_t val0 = 0, val1 = 0, val2 = 0;
-
-    // plane 0 (LSB)
-    if (r_top & 1) val0 |= 0x01;
-    if (g_top & 1) val0 |= 0x02;
-    if (b_top & 1) val0 |= 0x04;
-
-    if (r_bot & 1) val0 |= 0x08;
-    if (g_bot & 1) val0 |= 0x10;
-    if (b_bot & 1) val0 |= 0x20;
-
-    // plane 1
-    if (r_top & 2) val1 |= 0x01;
-    if (g_top & 2) val1 |= 0x02;
-    if (b_top & 2) val1 |= 0x04;
-
-    if (r_bot & 2) val1 |= 0x08;
-    if (g_bot & 2) val1 |= 0x10;
-    if (b_bot & 2) val1 |= 0x20;
-
-    // plane 2
-    if (r_top & 4) val2 |= 0x01;
-    if (g_top & 4) val2 |= 0x02;
-    if (b_top & 4) val2 |= 0x04;
-
-    if (r_bot & 4) val2 |= 0x08;
-    if (g_bot & 4) val2 |= 0x10;
-    if (b_bot & 4) val2 |= 0x20;
-
-    *p0++ = val0;
-    *p1++ = val1;
-    *p2++ = val2;
+    uint8_t addr = band * RENDER_BAND_ADDRS + i;
+    hub75_pack_band(&hub75_back()[addr], (const uint8_t *)&rows[i * HUB75_BAND_ROWS]);
   }
 }
+#endif
 
 void hub75_update_from_layers(uint64_t layer_update)
 {
-  // y가 속한 addr = y % 16
-  uint16_t addr_dirty = 0;
+  uint32_t addr_dirty = 0;
 
-  // 1. 바뀐 row(y)들을 보고, 해당 addr들을 표시
-  for (int y = 0; y < 64; ++y)
+  // 1. 바뀐 row(y)만 레이어에서 합성해서 fb (LAYER_FB 1 이면 팔레트 fb) 에 반영, 그 row 가 쓰이는 addr 들을 표시
+  //    (RGB 로 RENDER_BANDS 면 fb 없이 표시만, 패킹할 때 그 addr 의 row 들을 캡처, LAYER_FB 2 는 아래에서 그림)
+  for (int y = 0; y < HUB75_IMG_H; ++y)
   {
     if (layer_update & (1ULL << y))
     {
-      int addr = y & 0x0F; // y % 16
-      addr_dirty |= (1u << addr);
+#if LAYER_FB == 1
+      layer_draw_row(y);
+#elif LAYER_FB == 0 && !RENDER_BANDS
+      fb[y] = layer_capture_row(y);
+#endif
+      addr_dirty |= hub75_map_row_addrs((uint8_t)y);
     }
   }
 
-  // 2. 실제로 바뀐 addr 그룹만 HUB75로 전송
-  for (int addr = 0; addr < 16; ++addr)
+  // 2. back 버퍼는 두 프레임 전 내용. 지난번에 바뀐 addr 은 front 에 이미 패킹되어 있으므로
+  //    다시 합성/패킹하지 않고 복사만
+  static uint32_t prev_dirty = 0;
+  uint32_t stale = prev_dirty & ~addr_dirty;
+  prev_dirty = addr_dirty;
+
+#if LAYER_FB == 2
+  // 3. 바뀐 addr 도 front (지난 프레임 전체) 에서 가져온 뒤, 바뀐 row 만 그 위에 plane 비트로 다시 그림
+  hub75_copy_front(addr_dirty | stale);
+  bitfb_target(hub75_back());
+  for (int y = 0; y < HUB75_IMG_H; ++y)
   {
-    if (!(addr_dirty & (1u << addr)))
-      continue; // 이 주소 그룹은 이번 프레임에서 변화 없음
-
-    // 이 addr에 대해서:
-    //  - layer_capture_row(y0..y3)로 4개 논리 row 캡처해서 row_buffer 채우고
-    //  - render_row(addr)로 HUB75에 쏴준다
-    update_buffer_from_layers((uint8_t)addr);
-    render_row((uint8_t)addr);
+    if (layer_update & (1ULL << y)) layer_draw_row(y);
   }
+#else
+  // 3. 이번에 바뀐 addr 그룹만 back 버퍼에 패킹 (나머지는 front/back 모두 최신)
+  for (int addr = 0; addr < SCAN_LINES; ++addr)
+  {
+    if (addr_dirty & (1ul << addr))
+    {
+#if LAYER_FB == 1
+      fbpal_pack(&hub75_back()[addr], (uint8_t)addr); // 픽셀당 LUT 한 번
+#else
+      update_buffer_from_frame((uint8_t)addr);
+#endif
+    }
+  }
+  hub75_copy_front(stale);
+#endif
+
+  // 4. vsync 에서 교체 (전송은 백그라운드 스캔이 담당)
+  if (addr_dirty | stale) hub75_swap();
 }
 
 /* USER CODE END 4 */
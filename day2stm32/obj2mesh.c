@@ -0,0 +1,448 @@
+#ifdef HOST_BUILD
+// OBJ → mesh_t (3d.h) C 헤더 변환기 (호스트 전용)
+//   gcc -DHOST_BUILD obj2mesh.c -lm -o obj2mesh
+//   ./obj2mesh [-n 이름] [-16] [-p] [-s] [-c r,g,b] [-f fps] model.obj > mesh_model.h
+//
+// - v / f (n각형은 부채꼴로 삼각형 분할, 음수 인덱스, v/vt/vn 형식) / mtllib + usemtl 의 Kd 색
+// - 바운딩 박스 중심으로 옮기고 |좌표| <= 1 로 정규화, OBJ(오른손, z 가 화면 밖)를 렌더러 좌표(z 가 화면 안)로 z 반전
+// - 정점 int8 (기본, 1/127 단위) 또는 int16 (-16, 1/16384 단위), 정점 256개 이하면 인덱스 uint8
+// - 면 노멀은 양자화 전 좌표로 계산해서 int8 (127 = 1.0)
+// - -s: 꼭짓점 노멀 (붙은 면 노멀의 면적 가중 평균) 도 내보내서 Gouraud 로 그림
+//   OBJ 정점을 공유하는 면끼리는 모두 부드럽게 이어지므로, 각진 모서리는 모델에서 정점을 나눠 둘 것
+// - 모든 정점이 모든 면의 안쪽이면 볼록 → 뒷면 제거, 아니면 painter (-p 로 강제)
+// - 여러 각도에서 투영해 보고 Cortex-M4 84MHz 사이클을 추정해서 프레임당 삼각형 예산을 출력
+//   (추정 상수는 아래 CYC_*, 보드에서는 prof_stats 의 render 구간으로 맞춰 볼 것)
+
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Q16 메시 경로의 대략적인 비용 (사이클)
+#define CYC_VERT 70    // 정점 변환 (xform_batch, SMLAL 9) + 1/z + 투영
+#define CYC_FACE 25    // 모델 공간 뒷면 판정 내적 (또는 깊이 키)
+#define CYC_DRAW 130   // 그리는 면: 조명 내적 + 모서리 셋업
+#define CYC_ROW 60     // 스팬 한 줄: 모서리 누적 + memset 3번 호출
+#define CYC_PIXEL_X4 3 // 픽셀 4개당 (채널 3개 워드 저장)
+#define CYC_SORT 12    // painter: 면 하나 정렬 (지난 프레임 순서에 삽입 정렬, 호스트 토러스 면당 이동 0.5 번)
+#define CYC_VERT_LIGHT 15 // Gouraud: 꼭짓점 조명 내적
+#define CYC_PIXEL_G 6     // Gouraud: 픽셀 하나 (색 덧셈 3 + 바이트 저장 3)
+
+#define CPU_HZ 84000000.0
+#define RENDER_SHARE 0.5 // 프레임 시간 중 렌더에 쓸 비율 (나머지는 clear/pack/스캔 인터럽트)
+
+#define MAX_MTL 64
+
+typedef struct
+{
+  char name[64];
+  uint8_t rgb[3];
+} mtl_t;
+
+static float *vx;        // 정점 xyz
+static int nv, cap_v;
+static int *tri;         // 삼각형 정점 인덱스
+static uint8_t *tri_rgb; // 삼각형 색
+static int nt, cap_t;
+static mtl_t mtl[MAX_MTL];
+static int n_mtl;
+
+static void *grow(void *p, int *cap, int need, size_t elem)
+{
+  if (need <= *cap) return p;
+  *cap = need * 2 + 64;
+  p = realloc(p, (size_t)*cap * elem);
+  if (!p)
+  {
+    fprintf(stderr, "out of memory\n");
+    exit(1);
+  }
+  return p;
+}
+
+static void load_mtl(const char *obj_path, const char *file)
+{
+  char path[512];
+  const char *slash = strrchr(obj_path, '/');
+  int dir = slash ? (int)(slash - obj_path + 1) : 0;
+  snprintf(path, sizeof(path), "%.*s%s", dir, obj_path, file);
+
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+  {
+    fprintf(stderr, "warning: %s not found, default colour\n", path);
+    return;
+  }
+
+  char line[512];
+  while (fgets(line, sizeof(line), fp))
+  {
+    float r, g, b;
+    if (!strncmp(line, "newmtl ", 7) && n_mtl < MAX_MTL)
+    {
+      sscanf(line + 7, "%63s", mtl[n_mtl].name);
+      memset(mtl[n_mtl].rgb, 200, 3);
+      n_mtl++;
+    }
+    else if (n_mtl && sscanf(line, " Kd %f %f %f", &r, &g, &b) == 3)
+    {
+      mtl[n_mtl - 1].rgb[0] = (uint8_t)(fminf(fmaxf(r, 0), 1) * 255 + 0.5f);
+      mtl[n_mtl - 1].rgb[1] = (uint8_t)(fminf(fmaxf(g, 0), 1) * 255 + 0.5f);
+      mtl[n_mtl - 1].rgb[2] = (uint8_t)(fminf(fmaxf(b, 0), 1) * 255 + 0.5f);
+    }
+  }
+  fclose(fp);
+}
+
+static void load_obj(const char *path, const uint8_t *def_rgb)
+{
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+  {
+    perror(path);
+    exit(1);
+  }
+
+  uint8_t rgb[3] = {def_rgb[0], def_rgb[1], def_rgb[2]};
+  char line[1024];
+  while (fgets(line, sizeof(line), fp))
+  {
+    if (line[0] == 'v' && line[1] == ' ')
+    {
+      vx = grow(vx, &cap_v, nv + 1, 3 * sizeof(float));
+      if (sscanf(line + 2, "%f %f %f", &vx[nv * 3], &vx[nv * 3 + 1], &vx[nv * 3 + 2]) == 3) nv++;
+    }
+    else if (line[0] == 'f' && line[1] == ' ')
+    {
+      int idx[64], n = 0;
+      char *s = line + 2;
+      while (n < 64)
+      {
+        while (isspace((unsigned char)*s)) s++;
+        if (!*s) break;
+        int i = (int)strtol(s, &s, 10);
+        idx[n++] = (i < 0) ? nv + i : i - 1;
+        while (*s && !isspace((unsigned char)*s)) s++; // /vt/vn 건너뜀
+      }
+      for (int k = 2; k < n; k++) // 부채꼴 분할
+      {
+        tri = grow(tri, &cap_t, nt + 1, 3 * sizeof(int));
+        tri_rgb = realloc(tri_rgb, (size_t)cap_t * 3);
+        tri[nt * 3] = idx[0];
+        tri[nt * 3 + 1] = idx[k - 1];
+        tri[nt * 3 + 2] = idx[k];
+        memcpy(&tri_rgb[nt * 3], rgb, 3);
+        nt++;
+      }
+    }
+    else if (!strncmp(line, "mtllib ", 7))
+    {
+      char file[256];
+      if (sscanf(line + 7, "%255s", file) == 1) load_mtl(path, file);
+    }
+    else if (!strncmp(line, "usemtl ", 7))
+    {
+      char name[64];
+      memcpy(rgb, def_rgb, 3);
+      if (sscanf(line + 7, "%63s", name) == 1)
+        for (int i = 0; i < n_mtl; i++)
+          if (!strcmp(mtl[i].name, name)) memcpy(rgb, mtl[i].rgb, 3);
+    }
+  }
+  fclose(fp);
+
+  for (int i = 0; i < nt * 3; i++)
+  {
+    if (tri[i] < 0 || tri[i] >= nv)
+    {
+      fprintf(stderr, "%s: face index out of range\n", path);
+      exit(1);
+    }
+  }
+}
+
+// 바운딩 박스 중심 → 원점, 가장 먼 축 좌표 → 1, z 반전
+static void normalize(void)
+{
+  float lo[3] = {1e30f, 1e30f, 1e30f}, hi[3] = {-1e30f, -1e30f, -1e30f};
+  for (int i = 0; i < nv; i++)
+    for (int c = 0; c < 3; c++)
+    {
+      lo[c] = fminf(lo[c], vx[i * 3 + c]);
+      hi[c] = fmaxf(hi[c], vx[i * 3 + c]);
+    }
+
+  float ext = 0;
+  for (int c = 0; c < 3; c++) ext = fmaxf(ext, (hi[c] - lo[c]) * 0.5f);
+  if (ext <= 0) ext = 1;
+
+  for (int i = 0; i < nv; i++)
+    for (int c = 0; c < 3; c++)
+    {
+      float v = (vx[i * 3 + c] - (lo[c] + hi[c]) * 0.5f) / ext;
+      vx[i * 3 + c] = (c == 2) ? -v : v;
+    }
+}
+
+// 삼각형 t 의 바깥쪽 단위 노멀 (z 반전 후라서 감김 방향도 반대)
+static void tri_normal(int t, float *n)
+{
+  const float *a = &vx[tri[t * 3] * 3], *b = &vx[tri[t * 3 + 1] * 3], *c = &vx[tri[t * 3 + 2] * 3];
+  float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  n[0] = -(u[1] * v[2] - u[2] * v[1]);
+  n[1] = -(u[2] * v[0] - u[0] * v[2]);
+  n[2] = -(u[0] * v[1] - u[1] * v[0]);
+  float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  for (int k = 0; k < 3; k++) n[k] = (len > 0) ? n[k] / len : 0;
+}
+
+// 면적 0 삼각형 제거
+static void drop_degenerate(void)
+{
+  int out = 0;
+  for (int t = 0; t < nt; t++)
+  {
+    float n[3];
+    tri_normal(t, n);
+    if (n[0] == 0 && n[1] == 0 && n[2] == 0) continue;
+    memmove(&tri[out * 3], &tri[t * 3], 3 * sizeof(int));
+    memmove(&tri_rgb[out * 3], &tri_rgb[t * 3], 3);
+    out++;
+  }
+  if (out != nt) fprintf(stderr, "dropped %d degenerate triangles\n", nt - out);
+  nt = out;
+}
+
+static int is_convex(void)
+{
+  for (int t = 0; t < nt; t++)
+  {
+    float n[3];
+    tri_normal(t, n);
+    const float *a = &vx[tri[t * 3] * 3];
+    for (int i = 0; i < nv; i++)
+    {
+      const float *p = &vx[i * 3];
+      if ((p[0] - a[0]) * n[0] + (p[1] - a[1]) * n[1] + (p[2] - a[2]) * n[2] > 1e-4f) return 0;
+    }
+  }
+  return 1;
+}
+
+// render_mesh() 와 같은 카메라 (z + 3.5, 배율 33) 로 여러 각도에서 투영해서 평균 비용 추정
+typedef struct
+{
+  double drawn, rows, pixels;
+} cost_t;
+
+static cost_t estimate(int convex)
+{
+  cost_t c = {0, 0, 0};
+  int views = 0;
+  float *px = malloc((size_t)nv * 3 * sizeof(float));
+
+  for (int ix = 0; ix < 8; ix++)
+    for (int iy = 0; iy < 16; iy++, views++)
+    {
+      float ax = ix * 0.785f, ay = iy * 0.393f;
+      float cx = cosf(ax), sx = sinf(ax), cy = cosf(ay), sy = sinf(ay);
+      for (int i = 0; i < nv; i++)
+      {
+        const float *v = &vx[i * 3];
+        float x1 = v[0] * cy + v[2] * sy, z1 = -v[0] * sy + v[2] * cy;
+        float y2 = v[1] * cx - z1 * sx, z2 = v[1] * sx + z1 * cx;
+        float z = z2 + 3.5f;
+        px[i * 3] = x1 / z * 33;
+        px[i * 3 + 1] = -y2 / z * 33;
+        px[i * 3 + 2] = z;
+      }
+      for (int t = 0; t < nt; t++)
+      {
+        const float *a = &px[tri[t * 3] * 3], *b = &px[tri[t * 3 + 1] * 3], *d = &px[tri[t * 3 + 2] * 3];
+        if (convex) // render_mesh() 와 같은 판정: 회전한 노멀 · 카메라 기준 정점 >= 0 이면 뒷면
+        {
+          float n[3];
+          tri_normal(t, n);
+          const float *v = &vx[tri[t * 3] * 3];
+          float nx = n[0] * cy + n[2] * sy, nz1 = -n[0] * sy + n[2] * cy;
+          float ny = n[1] * cx - nz1 * sx, nz = n[1] * sx + nz1 * cx;
+          float x1 = v[0] * cy + v[2] * sy, z1 = -v[0] * sy + v[2] * cy;
+          float y2 = v[1] * cx - z1 * sx, z2 = v[1] * sx + z1 * cx + 3.5f;
+          if (nx * x1 + ny * y2 + nz * z2 >= 0) continue;
+        }
+        float area = ((b[0] - a[0]) * (d[1] - a[1]) - (d[0] - a[0]) * (b[1] - a[1])) * 0.5f;
+        float ylo = fminf(a[1], fminf(b[1], d[1])), yhi = fmaxf(a[1], fmaxf(b[1], d[1]));
+        c.drawn += 1;
+        c.rows += floorf(yhi) - ceilf(ylo) + 1;
+        c.pixels += fabsf(area);
+      }
+    }
+  free(px);
+  c.drawn /= views;
+  c.rows /= views;
+  c.pixels /= views;
+  return c;
+}
+
+static void emit_array(const char *type, const char *name, const long *v, int n, int per_line)
+{
+  printf("static const %s %s[%d] = {", type, name, n);
+  for (int i = 0; i < n; i++)
+  {
+    printf("%s%ld,", (i % per_line) ? " " : "\n    ", v[i]);
+  }
+  printf("};\n\n");
+}
+
+int main(int argc, char **argv)
+{
+  const char *name = NULL, *path = NULL;
+  int wide = 0, painter = 0, smooth = 0;
+  unsigned r = 200, g = 200, b = 200;
+  double fps = 60;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) name = argv[++i];
+    else if (!strcmp(argv[i], "-16")) wide = 1;
+    else if (!strcmp(argv[i], "-p")) painter = 1;
+    else if (!strcmp(argv[i], "-s")) smooth = 1;
+    else if (!strcmp(argv[i], "-c") && i + 1 < argc) sscanf(argv[++i], "%u,%u,%u", &r, &g, &b);
+    else if (!strcmp(argv[i], "-f") && i + 1 < argc) fps = atof(argv[++i]);
+    else path = argv[i];
+  }
+  if (!path)
+  {
+    fprintf(stderr, "usage: %s [-n name] [-16] [-p] [-s] [-c r,g,b] [-f fps] model.obj > mesh_model.h\n", argv[0]);
+    return 1;
+  }
+
+  char auto_name[64];
+  if (!name)
+  {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    int k = 0;
+    for (; base[k] && base[k] != '.' && k < 63; k++)
+      auto_name[k] = isalnum((unsigned char)base[k]) ? base[k] : '_';
+    auto_name[k] = 0;
+    name = auto_name;
+  }
+
+  uint8_t def_rgb[3] = {(uint8_t)r, (uint8_t)g, (uint8_t)b};
+  load_obj(path, def_rgb);
+  normalize();
+  drop_degenerate();
+  if (!nv || !nt)
+  {
+    fprintf(stderr, "%s: no geometry\n", path);
+    return 1;
+  }
+  if (nv > 256 * 256 - 1 || nt > 65535)
+  {
+    fprintf(stderr, "%s: too many vertices/faces\n", path);
+    return 1;
+  }
+
+  int convex = !painter && is_convex();
+  int unit = wide ? 16384 : 127;
+  long *buf = malloc((size_t)(nv > nt ? nv : nt) * 3 * sizeof(long));
+  char arr[96];
+
+  // 예산: (렌더 몫 사이클 - 정점 변환) / 그리는 면 하나의 평균 비용
+  cost_t c = estimate(convex);
+  double per_frame = CPU_HZ / fps * RENDER_SHARE;
+  double fixed = (double)nv * (CYC_VERT + (smooth ? CYC_VERT_LIGHT : 0)) +
+                 (double)nt * (CYC_FACE + (convex ? 0 : CYC_SORT));
+  double per_pixel = smooth ? CYC_PIXEL_G : CYC_PIXEL_X4 / 4.0;
+  double per_drawn = CYC_DRAW + (c.rows * CYC_ROW + c.pixels * per_pixel) / c.drawn;
+  double cycles = fixed + c.drawn * per_drawn;
+  double budget = (per_frame - fixed) / per_drawn;
+  uint16_t tri_budget = (budget < c.drawn) ? (uint16_t)(budget > 0 ? budget : 0) : 0;
+
+  printf("// %s: obj2mesh 로 생성 (%s)\n", name, path);
+  printf("// 정점 %d (int%d), 삼각형 %d, %s%s\n", nv, wide ? 16 : 8, nt, convex ? "볼록 (뒷면 제거)" : "painter",
+         smooth ? ", Gouraud" : "");
+  printf("// 추정 (Cortex-M4 84MHz, 평균 %.0f 면 / %.0f 줄 / %.0f 픽셀): %.0f 사이클/프레임 = %.2f ms\n",
+         c.drawn, c.rows, c.pixels, cycles, cycles / CPU_HZ * 1e3);
+  for (int f = 30; f <= 120; f *= 2)
+  {
+    double avail = CPU_HZ / f * RENDER_SHARE;
+    printf("//   %3d fps (렌더 %.0f%%): 그리는 면 %.0f 개까지\n", f, RENDER_SHARE * 100,
+           (avail - fixed) / per_drawn > 0 ? (avail - fixed) / per_drawn : 0.0);
+  }
+  printf("\n#include \"3d.h\"\n\n");
+
+  for (int i = 0; i < nv * 3; i++) buf[i] = lrintf(vx[i] * unit);
+  snprintf(arr, sizeof(arr), "%s_verts", name);
+  emit_array(wide ? "int16_t" : "int8_t", arr, buf, nv * 3, 12);
+
+  for (int i = 0; i < nt * 3; i++) buf[i] = tri[i];
+  snprintf(arr, sizeof(arr), "%s_faces", name);
+  emit_array(nv <= 256 ? "uint8_t" : "uint16_t", arr, buf, nt * 3, 12);
+
+  for (int t = 0; t < nt; t++)
+  {
+    float n[3];
+    tri_normal(t, n);
+    for (int k = 0; k < 3; k++) buf[t * 3 + k] = lrintf(n[k] * 127);
+  }
+  snprintf(arr, sizeof(arr), "%s_normals", name);
+  emit_array("int8_t", arr, buf, nt * 3, 12);
+
+  if (smooth)
+  {
+    // 면적 가중: 정규화 전 외적 길이 = 삼각형 면적 × 2
+    float *acc = calloc((size_t)nv * 3, sizeof(float));
+    for (int t = 0; t < nt; t++)
+    {
+      float n[3];
+      tri_normal(t, n);
+      const float *a = &vx[tri[t * 3] * 3], *b = &vx[tri[t * 3 + 1] * 3], *d = &vx[tri[t * 3 + 2] * 3];
+      float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      float v[3] = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+      float cx = u[1] * v[2] - u[2] * v[1], cy = u[2] * v[0] - u[0] * v[2], cz = u[0] * v[1] - u[1] * v[0];
+      float area = sqrtf(cx * cx + cy * cy + cz * cz);
+      for (int k = 0; k < 3; k++)
+        for (int j = 0; j < 3; j++) acc[tri[t * 3 + k] * 3 + j] += n[j] * area;
+    }
+    for (int i = 0; i < nv; i++)
+    {
+      float *n = &acc[i * 3];
+      float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for (int k = 0; k < 3; k++) buf[i * 3 + k] = (len > 0) ? lrintf(n[k] / len * 127) : 0;
+    }
+    free(acc);
+    snprintf(arr, sizeof(arr), "%s_vnormals", name);
+    emit_array("int8_t", arr, buf, nv * 3, 12);
+  }
+
+  for (int i = 0; i < nt * 3; i++) buf[i] = tri_rgb[i];
+  snprintf(arr, sizeof(arr), "%s_colors", name);
+  emit_array("uint8_t", arr, buf, nt * 3, 12);
+
+  printf("static const mesh_t mesh_%s = {\n", name);
+  printf("    .%s = %s_verts,\n", wide ? "v16" : "v8", name);
+  printf("    .%s = %s_faces,\n", nv <= 256 ? "i8" : "i16", name);
+  printf("    .normals = %s_normals,\n", name);
+  printf("    .colors = %s_colors,\n", name);
+  if (smooth) printf("    .vnormals = %s_vnormals,\n", name);
+  printf("    .n_verts = %d,\n", nv);
+  printf("    .n_faces = %d,\n", nt);
+  printf("    .face_verts = 3,\n");
+  printf("    .convex = %d,\n", convex);
+  printf("    .tri_budget = %u, // %.0f fps 기준%s\n", tri_budget, fps, tri_budget ? "" : ", 예산 안이라 제한 없음");
+  printf("    .scale = %d,\n", (65536 + unit / 2) / unit);
+  printf("};\n");
+
+  fprintf(stderr, "%s: %d verts, %d tris, %s, %.0f cycles/frame, budget %.0f faces @ %.0f fps\n",
+          name, nv, nt, convex ? "convex" : "painter", cycles, budget, fps);
+  if (nv > 256) fprintf(stderr, "warning: %d verts > MESH_MAX_VERTS (256)\n", nv);
+  if (nt > 512) fprintf(stderr, "warning: %d faces > MESH_MAX_FACES (512)\n", nt);
+  free(buf);
+  return 0;
+}
+#endif
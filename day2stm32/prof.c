@@ -0,0 +1,108 @@
+#include "prof.h"
+#include "hub75.h"
+#include <stdio.h>
+
+volatile prof_stats_t prof_stats;
+
+#if PROF_ENABLE
+
+#ifdef HOST_BUILD
+#include <time.h>
+
+uint32_t prof_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+static const char *const stage_name[PROF_STAGES] = {
+    "clear", "render", "pack", "swap", "frame", "layer",
+    "shift", "hold", "scan_irq", "scan_frame",
+};
+
+void prof_reset(void)
+{
+  for (uint8_t i = 0; i < PROF_STAGES; i++)
+  {
+    volatile prof_stat_t *st = &prof_stats.stage[i];
+    st->last = 0;
+    st->min = 0xFFFFFFFFu;
+    st->max = 0;
+    st->count = 0;
+    st->sum = 0;
+  }
+  prof_stats.refresh_hz = 0;
+  prof_stats.fps = 0;
+  prof_stats.pixel_khz = 0;
+  prof_stats.draw_fps = 0;
+  prof_stats.sim_hz = 0;
+}
+
+void prof_init(void)
+{
+#ifndef HOST_BUILD
+  // DWT 사이클 카운터 켜기 (디버거가 없어도 TRCENA 만 세우면 동작)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  prof_stats.clock_hz = SystemCoreClock;
+#else
+  prof_stats.clock_hz = 1000000000u;
+#endif
+  prof_reset();
+}
+
+// 메인 루프와 스캔 인터럽트가 서로 다른 구간만 쓰므로 잠금 없이 갱신
+void prof_add(prof_stage_t s, uint32_t t)
+{
+  volatile prof_stat_t *st = &prof_stats.stage[s];
+
+  st->last = t;
+  if (t < st->min) st->min = t;
+  if (t > st->max) st->max = t;
+  st->count++;
+  st->sum += t;
+
+  // 평균 기준 Hz 는 프레임당 한 번만 계산
+  if (s == PROF_SCAN_FRAME || s == PROF_FRAME)
+  {
+    uint32_t avg = (uint32_t)(st->sum / st->count);
+    uint32_t hz = avg ? prof_stats.clock_hz / avg : 0;
+    if (s == PROF_SCAN_FRAME) prof_stats.refresh_hz = hz;
+    else prof_stats.fps = hz;
+  }
+
+  // 픽셀 클럭도 plane 마다가 아니라 리프레시 한 번에 한 번
+  if (s == PROF_SCAN_FRAME && prof_stats.stage[PROF_SHIFT].count)
+  {
+    volatile prof_stat_t *sh = &prof_stats.stage[PROF_SHIFT];
+    uint32_t avg = (uint32_t)(sh->sum / sh->count);
+    prof_stats.pixel_khz = avg ? (uint32_t)((uint64_t)prof_stats.clock_hz * PANEL_WIDTH_TOTAL / avg / 1000u) : 0;
+  }
+}
+
+static uint32_t to_us(uint64_t t)
+{
+  return (uint32_t)(t * 1000000u / prof_stats.clock_hz);
+}
+
+void prof_print(void)
+{
+  printf("stage         count    last     min     max     avg (us)\r\n");
+  for (uint8_t i = 0; i < PROF_STAGES; i++)
+  {
+    volatile prof_stat_t *st = &prof_stats.stage[i];
+    if (!st->count) continue;
+    printf("%-10s %8lu %7lu %7lu %7lu %7lu\r\n", stage_name[i], (unsigned long)st->count,
+           (unsigned long)to_us(st->last), (unsigned long)to_us(st->min),
+           (unsigned long)to_us(st->max), (unsigned long)to_us(st->sum / st->count));
+  }
+  printf("refresh %lu Hz, render %lu fps, pixel clock %lu kHz\r\n", (unsigned long)prof_stats.refresh_hz,
+         (unsigned long)prof_stats.fps, (unsigned long)prof_stats.pixel_khz);
+  printf("drawn %lu fps, animation %lu steps/s\r\n", (unsigned long)prof_stats.draw_fps,
+         (unsigned long)prof_stats.sim_hz);
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef _PROF_H_
+#define _PROF_H_
+
+// 렌더/스캔 파이프라인 구간별 시간 측정
+// - 보드: Cortex-M4 DWT 사이클 카운터 (CYCCNT), 단위 = 코어 클럭 1 사이클
+// - HOST_BUILD: clock_gettime(CLOCK_MONOTONIC), 단위 = 1ns
+// 결과는 전역 prof_stats 에 쌓이므로 디버거(Live Expressions)로 바로 보거나,
+// prof_print() 로 printf(보드에서는 _write 를 UART 로 연결) 출력
+// PROF_ENABLE=0 이면 측정 코드는 전부 빈 inline 이 되어 사라짐
+
+#include <stdint.h>
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 1
+#endif
+
+typedef enum
+{
+  // 메인 루프 (큐브 모드 한 프레임)
+  PROF_CLEAR,  // clear_framebuffer()
+  PROF_RENDER, // render_cube_frame()
+  PROF_PACK,   // update_buffer_from_frame() × SCAN_LINES
+  PROF_SWAP,   // hub75_swap() 에서 vsync 대기
+  PROF_FRAME,  // 위 네 구간 합 (한 프레임)
+  PROF_LAYER,  // hub75_update_from_layers() (레이어 모드 한 스텝)
+  // 스캔 (인터럽트)
+  PROF_SHIFT,      // plane 하나 128컬럼 시프트 (DMA 시작 → 완료 / CPU 비트뱅잉)
+  PROF_HOLD,       // OE 펄스 시작 → 끝 (plane 평균)
+  PROF_SCAN_IRQ,   // 스캔 인터럽트 안에서 쓴 CPU 시간
+  PROF_SCAN_FRAME, // vsync → vsync (리프레시 한 번)
+  PROF_STAGES
+} prof_stage_t;
+
+typedef struct
+{
+  uint32_t last;
+  uint32_t min;
+  uint32_t max;
+  uint32_t count;
+  uint64_t sum;
+} prof_stat_t;
+
+typedef struct
+{
+  uint32_t clock_hz;   // prof_now() 단위 (보드: SystemCoreClock, 호스트: 1e9)
+  uint32_t refresh_hz; // PROF_SCAN_FRAME 평균으로 구한 실측 리프레시율
+  uint32_t fps;        // PROF_FRAME 평균으로 구한 렌더 프레임율
+  uint32_t pixel_khz;  // PROF_SHIFT 평균으로 구한 픽셀 클럭 (128컬럼 / 시프트 시간)
+  uint32_t draw_fps;   // 1초 동안 실제로 그린 프레임 수 (anim.c)
+  uint32_t sim_hz;     // 1초 동안 돈 애니메이션 스텝 수 (anim.c, ANIM_HZ 근처여야 정상)
+  prof_stat_t stage[PROF_STAGES];
+} prof_stats_t;
+
+extern volatile prof_stats_t prof_stats;
+
+#if PROF_ENABLE
+
+#ifndef HOST_BUILD
+#include "main.h"
+static inline uint32_t prof_now(void) { return DWT->CYCCNT; }
+#else
+uint32_t prof_now(void);
+#endif
+
+void prof_init(void);  // DWT 켜고 통계 초기화
+void prof_reset(void); // 통계만 초기화
+void prof_add(prof_stage_t s, uint32_t t);
+void prof_print(void);
+
+// *t 부터 지금까지를 s 에 더하고 *t 를 지금으로 (연속 구간 측정용)
+static inline void prof_lap(prof_stage_t s, uint32_t *t)
+{
+  uint32_t now = prof_now();
+  prof_add(s, now - *t);
+  *t = now;
+}
+
+#else
+
+static inline uint32_t prof_now(void) { return 0; }
+static inline void prof_init(void) {}
+static inline void prof_reset(void) {}
+static inline void prof_add(prof_stage_t s, uint32_t t) { (void)s; (void)t; }
+static inline void prof_print(void) {}
+static inline void prof_lap(prof_stage_t s, uint32_t *t) { (void)s; (void)t; }
+
+#endif
+
+#endif
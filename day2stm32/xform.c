@@ -0,0 +1,326 @@
+#include "xform.h"
+#include <string.h>
+
+// sin(i/256 × π/2), i = 0..256 (Q16)
+static const int32_t sin_q16[257] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617,
+    4019, 4420, 4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623,
+    8022, 8421, 8820, 9218, 9616, 10014, 10411, 10808, 11204, 11600,
+    11996, 12391, 12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+    15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639, 19024, 19409,
+    19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210,
+    23586, 23961, 24335, 24708, 25080, 25451, 25821, 26190, 26558, 26925,
+    27291, 27656, 28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347, 33692, 34037,
+    34380, 34721, 35062, 35401, 35738, 36075, 36410, 36744, 37076, 37407,
+    37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002, 40320, 40636,
+    40951, 41264, 41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056, 46341, 46624,
+    46906, 47186, 47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361,
+    49624, 49886, 50146, 50404, 50660, 50914, 51166, 51417, 51665, 51911,
+    52156, 52398, 52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004, 56212, 56418,
+    56621, 56823, 57022, 57219, 57414, 57607, 57798, 57986, 58172, 58356,
+    58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075,
+    60235, 60392, 60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+    61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596, 62714, 62830,
+    62943, 63054, 63162, 63268, 63372, 63473, 63572, 63668, 63763, 63854,
+    63944, 64031, 64115, 64197, 64277, 64354, 64429, 64501, 64571, 64639,
+    64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476,
+    65492, 65505, 65516, 65525, 65531, 65535, 65536,
+};
+
+// a: ANGLE_STEPS 단위 각도, 사분면 표 칸 사이는 하위 6비트로 선형 보간 (오차 < 1e-5)
+int32_t sin_q(uint16_t a)
+{
+  uint16_t j = (a >> 6) & 255, f = a & 63;
+  int32_t s;
+
+  if (a & 0x4000) // 2, 4 사분면은 표를 거꾸로
+  {
+    j = 255 - j;
+    f = 64 - f;
+  }
+  s = sin_q16[j] + (((sin_q16[j + 1] - sin_q16[j]) * f) >> 6);
+  return (a & 0x8000) ? -s : s;
+}
+
+int32_t cos_q(uint16_t a) { return sin_q(a + ANGLE_STEPS / 4); }
+
+void mat4_identity(mat4_t *m)
+{
+  memset(m, 0, sizeof(*m));
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    m->m[i][i] = Q16_ONE;
+  }
+}
+
+void mat4_translate(mat4_t *m, int32_t x, int32_t y, int32_t z)
+{
+  mat4_identity(m);
+  m->m[0][3] = x;
+  m->m[1][3] = y;
+  m->m[2][3] = z;
+}
+
+void mat4_euler(mat4_t *m, uint16_t ax, uint16_t ay, uint16_t az)
+{
+  int32_t cx = cos_q(ax), sx = sin_q(ax);
+  int32_t cy = cos_q(ay), sy = sin_q(ay);
+  int32_t cz = cos_q(az), sz = sin_q(az);
+
+  // Ry Rz 를 먼저 만들고 X 축 회전으로 행 1, 2 를 섞음
+  int32_t r1[3] = {sz, cz, 0};
+  int32_t r2[3] = {-qmul(sy, cz), qmul(sy, sz), cy};
+
+  mat4_identity(m);
+  m->m[0][0] = qmul(cy, cz);
+  m->m[0][1] = -qmul(cy, sz);
+  m->m[0][2] = sy;
+  for (uint8_t j = 0; j < 3; j++)
+  {
+    m->m[1][j] = qmul(r1[j], cx) - qmul(r2[j], sx);
+    m->m[2][j] = qmul(r1[j], sx) + qmul(r2[j], cx);
+  }
+}
+
+void mat4_quat(mat4_t *m, const int32_t *q)
+{
+  int32_t w = q[0], x = q[1], y = q[2], z = q[3];
+  int32_t xx = qmul(x, x), yy = qmul(y, y), zz = qmul(z, z);
+  int32_t xy = qmul(x, y), xz = qmul(x, z), yz = qmul(y, z);
+  int32_t wx = qmul(w, x), wy = qmul(w, y), wz = qmul(w, z);
+
+  mat4_identity(m);
+  m->m[0][0] = Q16_ONE - 2 * (yy + zz);
+  m->m[0][1] = 2 * (xy - wz);
+  m->m[0][2] = 2 * (xz + wy);
+  m->m[1][0] = 2 * (xy + wz);
+  m->m[1][1] = Q16_ONE - 2 * (xx + zz);
+  m->m[1][2] = 2 * (yz - wx);
+  m->m[2][0] = 2 * (xz - wy);
+  m->m[2][1] = 2 * (yz + wx);
+  m->m[2][2] = Q16_ONE - 2 * (xx + yy);
+}
+
+void mat4_project(mat4_t *m, int32_t s, int32_t cx, int32_t cy)
+{
+  memset(m, 0, sizeof(*m));
+  m->m[0][0] = s * Q16_ONE;
+  m->m[0][2] = cx * Q16_ONE;
+  m->m[1][1] = -s * Q16_ONE;
+  m->m[1][2] = cy * Q16_ONE;
+  m->m[2][2] = Q16_ONE;
+  m->m[3][2] = Q16_ONE;
+}
+
+void mat4_mul(mat4_t *out, const mat4_t *a, const mat4_t *b)
+{
+  mat4_t r;
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    for (uint8_t j = 0; j < 4; j++)
+    {
+      int64_t acc = 0;
+      for (uint8_t k = 0; k < 4; k++)
+      {
+        acc += (int64_t)a->m[i][k] * b->m[k][j];
+      }
+      r.m[i][j] = (int32_t)(acc >> 16);
+    }
+  }
+  *out = r;
+}
+
+void mat4_inverse_rigid(mat4_t *out, const mat4_t *m)
+{
+  mat4_t r;
+  mat4_identity(&r);
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    for (uint8_t j = 0; j < 3; j++)
+    {
+      r.m[i][j] = m->m[j][i];
+    }
+  }
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    r.m[i][3] = -(int32_t)(((int64_t)r.m[i][0] * m->m[0][3] + (int64_t)r.m[i][1] * m->m[1][3] +
+                            (int64_t)r.m[i][2] * m->m[2][3]) >> 16);
+  }
+  *out = r;
+}
+
+void mat4_point(const mat4_t *m, const int32_t *in, int32_t *out)
+{
+  int32_t v[3] = {in[0], in[1], in[2]};
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    out[i] = (int32_t)(((int64_t)m->m[i][0] * v[0] + (int64_t)m->m[i][1] * v[1] +
+                        (int64_t)m->m[i][2] * v[2]) >> 16) + m->m[i][3];
+  }
+}
+
+void mat4_dir(const mat4_t *m, const int32_t *in, int32_t *out)
+{
+  int32_t v[3] = {in[0], in[1], in[2]};
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    out[i] = (int32_t)(((int64_t)m->m[i][0] * v[0] + (int64_t)m->m[i][1] * v[1] +
+                        (int64_t)m->m[i][2] * v[2]) >> 16);
+  }
+}
+
+// 행렬 12 칸을 루프 밖에서 지역 변수로 (M4 는 레지스터 13 개라 일부는 스택, 그래도 칸마다 주소 계산은 없음)
+// 루프 안은 분기 없이 load 3 → SMULL/SMLAL 9 → 시프트/덧셈 → store 3 이라 파이프라인이 끊기지 않음
+void xform_batch(const mat4_t *m, const int32_t *x, const int32_t *y, const int32_t *z, uint16_t n,
+                 int32_t *ox, int32_t *oy, int32_t *oz)
+{
+  const int32_t m00 = m->m[0][0], m01 = m->m[0][1], m02 = m->m[0][2], m03 = m->m[0][3];
+  const int32_t m10 = m->m[1][0], m11 = m->m[1][1], m12 = m->m[1][2], m13 = m->m[1][3];
+  const int32_t m20 = m->m[2][0], m21 = m->m[2][1], m22 = m->m[2][2], m23 = m->m[2][3];
+
+  for (uint16_t i = 0; i < n; i++)
+  {
+    int64_t vx = x[i], vy = y[i], vz = z[i];
+
+    ox[i] = (int32_t)((m00 * vx + m01 * vy + m02 * vz) >> 16) + m03;
+    oy[i] = (int32_t)((m10 * vx + m11 * vy + m12 * vz) >> 16) + m13;
+    oz[i] = (int32_t)((m20 * vx + m21 * vy + m22 * vz) >> 16) + m23;
+  }
+}
+
+void quat_mul(int32_t *out, const int32_t *a, const int32_t *b)
+{
+  int32_t w = qmul(a[0], b[0]) - qmul(a[1], b[1]) - qmul(a[2], b[2]) - qmul(a[3], b[3]);
+  int32_t x = qmul(a[0], b[1]) + qmul(a[1], b[0]) + qmul(a[2], b[3]) - qmul(a[3], b[2]);
+  int32_t y = qmul(a[0], b[2]) - qmul(a[1], b[3]) + qmul(a[2], b[0]) + qmul(a[3], b[1]);
+  int32_t z = qmul(a[0], b[3]) + qmul(a[1], b[2]) - qmul(a[2], b[1]) + qmul(a[3], b[0]);
+
+  out[0] = w;
+  out[1] = x;
+  out[2] = y;
+  out[3] = z;
+}
+
+void quat_axis_angle(int32_t *q, const int32_t *axis, uint16_t a)
+{
+  int32_t s = sin_q(a / 2);
+
+  q[0] = cos_q(a / 2);
+  q[1] = qmul(axis[0], s);
+  q[2] = qmul(axis[1], s);
+  q[3] = qmul(axis[2], s);
+}
+
+#if defined(HOST_BUILD) && defined(XFORM_MAIN)
+// 호스트 확인: 사원수 경로가 오일러/행렬 곱과 같은 회전을 만드는지 (부호, 곱 순서)
+//   gcc -O2 -DHOST_BUILD -DXFORM_MAIN xform.c -lm -o xform && ./xform
+// - X/Y/Z 축 사원수 → mat4_quat 가 mat4_euler 의 한 축 회전과 같음
+// - qx qy qz (qz 먼저) 가 mat4_euler (M = Rx Ry Rz) 와 같음
+// - 임의 축 두 사원수: mat4_quat(a b) 가 mat4_mul(mat4_quat(a), mat4_quat(b)) 와 같음
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK_ROUNDS 10000
+#define CHECK_TOL 64 // Q16 칸 (1e-3): 반올림 오차는 30 칸 안팎, 부호/순서가 틀리면 수만 칸
+
+static int32_t max_err;
+
+static void cmp3(const mat4_t *a, const mat4_t *b)
+{
+  for (uint8_t i = 0; i < 3; i++)
+    for (uint8_t j = 0; j < 3; j++)
+    {
+      int32_t e = abs(a->m[i][j] - b->m[i][j]);
+      if (e > max_err) max_err = e;
+    }
+}
+
+static void random_axis(int32_t *axis)
+{
+  float v[3], n;
+  do
+  {
+    for (uint8_t i = 0; i < 3; i++) v[i] = rand() / (float)RAND_MAX * 2.0f - 1.0f;
+    n = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  } while (n < 0.1f || n > 1.0f);
+  for (uint8_t i = 0; i < 3; i++) axis[i] = (int32_t)lrintf(v[i] / n * Q16_ONE);
+}
+
+int main(void)
+{
+  static const int32_t ax_x[3] = {Q16_ONE, 0, 0}, ax_y[3] = {0, Q16_ONE, 0}, ax_z[3] = {0, 0, Q16_ONE};
+  int32_t err_axis, err_euler, err_mul;
+  srand(1);
+
+  for (int k = 0; k < CHECK_ROUNDS; k++)
+  {
+    uint16_t a = (uint16_t)rand(), b = (uint16_t)rand(), c = (uint16_t)rand();
+    int32_t qx[4], qy[4], qz[4];
+    mat4_t e, m;
+
+    quat_axis_angle(qx, ax_x, a);
+    quat_axis_angle(qy, ax_y, b);
+    quat_axis_angle(qz, ax_z, c);
+    mat4_euler(&e, a, 0, 0);
+    mat4_quat(&m, qx);
+    cmp3(&e, &m);
+    mat4_euler(&e, 0, b, 0);
+    mat4_quat(&m, qy);
+    cmp3(&e, &m);
+    mat4_euler(&e, 0, 0, c);
+    mat4_quat(&m, qz);
+    cmp3(&e, &m);
+  }
+  err_axis = max_err;
+
+  max_err = 0;
+  for (int k = 0; k < CHECK_ROUNDS; k++)
+  {
+    uint16_t a = (uint16_t)rand(), b = (uint16_t)rand(), c = (uint16_t)rand();
+    int32_t qx[4], qy[4], qz[4], q[4];
+    mat4_t e, m;
+
+    quat_axis_angle(qx, ax_x, a);
+    quat_axis_angle(qy, ax_y, b);
+    quat_axis_angle(qz, ax_z, c);
+    quat_mul(q, qy, qz);
+    quat_mul(q, qx, q);
+    mat4_euler(&e, a, b, c);
+    mat4_quat(&m, q);
+    cmp3(&e, &m);
+  }
+  err_euler = max_err;
+
+  max_err = 0;
+  for (int k = 0; k < CHECK_ROUNDS; k++)
+  {
+    int32_t axis_a[3], axis_b[3], qa[4], qb[4], q[4];
+    mat4_t ma, mb, m, p;
+
+    random_axis(axis_a);
+    random_axis(axis_b);
+    quat_axis_angle(qa, axis_a, (uint16_t)rand());
+    quat_axis_angle(qb, axis_b, (uint16_t)rand());
+    quat_mul(q, qa, qb);
+    mat4_quat(&ma, qa);
+    mat4_quat(&mb, qb);
+    mat4_mul(&p, &ma, &mb);
+    mat4_quat(&m, q);
+    cmp3(&p, &m);
+  }
+  err_mul = max_err;
+
+  printf("quaternion vs matrix, %d rounds (max error, Q16 units)\n", CHECK_ROUNDS);
+  printf("  axis  quat vs euler   : %d\n", err_axis);
+  printf("  qx qy qz vs euler xyz : %d\n", err_euler);
+  printf("  quat_mul vs mat4_mul  : %d\n", err_mul);
+  int bad = err_axis > CHECK_TOL || err_euler > CHECK_TOL || err_mul > CHECK_TOL;
+  printf("  %s (tolerance %d)\n", bad ? "MISMATCH" : "ok", CHECK_TOL);
+  return bad;
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef _XFORM_H_
+#define _XFORM_H_
+
+// 4×4 변환 행렬 (Q16 고정소수점)
+// 오일러 각/사원수로 회전 행렬을 만들고, 평행이동/투영과 곱해서 행렬 하나로 합친 뒤
+// 정점 배열(SoA)을 한 번에 변환한다. 곱셈은 int64 로 받아서 >> 16 (Cortex-M4 SMULL/SMLAL)
+// 행렬은 m[행][열], 열 벡터 기준 (v' = M v), mat4_mul(out, a, b) 는 b 를 먼저 적용
+
+#include <stdint.h>
+
+#define Q16_ONE 65536
+#define ANGLE_STEPS 65536 // 한 바퀴 = uint16 전체 (표 1024 칸 사이는 선형 보간)
+
+typedef struct
+{
+  int32_t m[4][4];
+} mat4_t;
+
+static inline int32_t qmul(int32_t a, int32_t b)
+{
+  return (int32_t)(((int64_t)a * b) >> 16);
+}
+
+// float 각도(rad) → ANGLE_STEPS 단위
+static inline uint16_t angle_q(float a)
+{
+  return (uint16_t)(int32_t)(a * (ANGLE_STEPS / 6.28318531f) + (a >= 0.0f ? 0.5f : -0.5f));
+}
+
+int32_t sin_q(uint16_t a); // Q16, 오차 < 1e-5
+int32_t cos_q(uint16_t a);
+
+void mat4_identity(mat4_t *m);
+void mat4_translate(mat4_t *m, int32_t x, int32_t y, int32_t z);
+// Z → Y → X 축 순서로 돌리는 회전 (M = Rx Ry Rz), 각도는 ANGLE_STEPS 단위
+void mat4_euler(mat4_t *m, uint16_t ax, uint16_t ay, uint16_t az);
+// 단위 사원수 q = (w, x, y, z) Q16 → 회전 행렬
+void mat4_quat(mat4_t *m, const int32_t *q);
+// 원근 투영: x' = s x + cx z, y' = -s y + cy z, z' = w' = z
+// 화면 좌표 = (x' / z', y' / z'), s 는 정수 배율, (cx, cy) 는 화면 중심 (픽셀)
+void mat4_project(mat4_t *m, int32_t s, int32_t cx, int32_t cy);
+void mat4_mul(mat4_t *out, const mat4_t *a, const mat4_t *b); // out = a b, out 이 a/b 와 같아도 됨
+// 회전 + 평행이동 행렬의 역행렬 (회전 부분 전치, 평행이동은 -Rᵀt)
+void mat4_inverse_rigid(mat4_t *out, const mat4_t *m);
+
+// 점 하나 (w = 1) / 방향 하나 (평행이동 없이)
+void mat4_point(const mat4_t *m, const int32_t *in, int32_t *out);
+void mat4_dir(const mat4_t *m, const int32_t *in, int32_t *out);
+
+// SoA 배열 n 개를 행 0~2 로 변환 (행 3 은 보지 않음, 원근이면 행 2 = w 로 호출 쪽에서 나눔)
+// 출력은 입력과 같은 배열이어도 됨 (한 정점의 x, y, z 를 다 읽고 씀)
+void xform_batch(const mat4_t *m, const int32_t *x, const int32_t *y, const int32_t *z, uint16_t n,
+                 int32_t *ox, int32_t *oy, int32_t *oz);
+
+// 사원수 곱 out = a b (b 를 먼저 적용), 단위 축 (Q16) 둘레로 각도 a 만큼 도는 사원수
+// 곱을 계속 쌓으면 길이가 조금씩 어긋나므로 가끔 quat_axis_angle 로 다시 만들 것
+void quat_mul(int32_t *out, const int32_t *a, const int32_t *b);
+void quat_axis_angle(int32_t *q, const int32_t *axis, uint16_t a);
+
+#endif